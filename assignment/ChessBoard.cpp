@@ -3,13 +3,15 @@
 #include "framework/VertexArray.h"
 #include "framework/VertexBuffer.h"
 #include "framework/Texture.h"
+#include "framework/Sampler.h"
 #include "GLFW/glfw3.h"
-#include "framework/Camera.h"
+#include "framework/ShaderSource.h"
 #include "constants.h"
 
 // language=glsl
 const std::string vertexShaderSource = R"(
     #version 450 core
+    #include "framework/frame_uniforms.glsl"
 
     layout(location = 0) in vec2 position;
     layout(location = 1) in vec2 texture_coordinates;
@@ -20,15 +22,13 @@ const std::string vertexShaderSource = R"(
         vec2 grid_position;
     } vertex_data;
 
-    uniform mat4 projection;
-    uniform mat4 view;
     uniform mat4 model;
 
     void main() {
         vertex_data.texture_coordinates = texture_coordinates;
         vertex_data.grid_position = grid_position;
 
-        gl_Position = projection * view * model * vec4(position.xy, 0.0, 1.0);
+        gl_Position = frame.view_projection * model * vec4(position.xy, 0.0, 1.0);
     }
 )";
 
@@ -68,8 +68,16 @@ const std::string fragmentShaderSource = R"(
     }
 )";
 
-ChessBoard ChessBoard::create() {
-    auto chessboardShader = std::make_shared<framework::Shader>(vertexShaderSource, fragmentShaderSource);
+framework::PendingShader ChessBoard::compileShader() {
+    return {framework::preprocessShader(vertexShaderSource), framework::preprocessShader(fragmentShaderSource)};
+}
+
+ChessBoard ChessBoard::create(
+    framework::PendingShader &shader,
+    framework::TextureStreamer &textureStreamer,
+    const framework::AssetPack &assets
+) {
+    auto chessboardShader = shader.get();
 
     chessboardShader->uploadUniformMatrix4("model", glm::mat4(1.0f));
     chessboardShader->uploadUniformInt1("board_size", BOARD_SIZE);
@@ -117,7 +125,7 @@ ChessBoard ChessBoard::create() {
         framework::IndexBuffer(chessboardIndices)
     );
 
-    auto texture = framework::loadTexture(RESOURCES_DIR + std::string("textures/floor_texture.png"));
+    auto texture = textureStreamer.load(assets.asset("textures/floor_texture.png"));
 
     return {
         .vertexArray = std::move(vertexArray),
@@ -125,13 +133,12 @@ ChessBoard ChessBoard::create() {
     };
 }
 
-void ChessBoard::draw(glm::ivec2 selectedTile, bool useTextures, const framework::Camera &camera) const {
-    vertexArray.shader->uploadUniformBool1("use_textures", useTextures);
-    vertexArray.shader->uploadUniformInt2("selected_tile", selectedTile);
-
-    vertexArray.shader->uploadUniformMatrix4("projection", camera.projectionMatrix);
-    vertexArray.shader->uploadUniformMatrix4("view", camera.viewMatrix());
+void ChessBoard::draw(framework::DrawQueue &drawQueue, glm::ivec2 selectedTile, bool useTextures) const {
+    auto drawCommand = vertexArray.drawCommand()
+        .withUniform("use_textures", useTextures)
+        .withUniform("selected_tile", selectedTile)
+        .withTexture(0, *texture, framework::samplerCache().sampler({.anisotropy = 8.f}))
+        .withLabel("ChessBoard");
 
-    texture.bind();
-    vertexArray.draw();
+    drawQueue.submit(std::move(drawCommand));
 }
\ No newline at end of file
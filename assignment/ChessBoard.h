@@ -4,8 +4,10 @@
 #include "glm/ext/vector_int2.hpp"
 #include "glm/vec2.hpp"
 #include "framework/VertexArray.h"
-#include "framework/Texture.h"
-#include "framework/Camera.h"
+#include "framework/TextureStreamer.h"
+#include "framework/DrawQueue.h"
+#include "framework/PendingShader.h"
+#include "framework/AssetPack.h"
 
 struct ChessBoard {
     struct Vertex {
@@ -20,11 +22,21 @@ struct ChessBoard {
     };
 
     const framework::VertexArray<Vertex> vertexArray;
-    const framework::Texture texture;
+    /// Placeholder until streamed in
+    const std::shared_ptr<framework::Texture> texture;
 
-    static ChessBoard create();
+    /**
+     * Start compiling the shader, so it can compile while other work is done
+     */
+    static framework::PendingShader compileShader();
 
-    void draw(glm::ivec2 selectedTile, bool useTextures, const framework::Camera &camera) const;
+    static ChessBoard create(
+        framework::PendingShader &shader,
+        framework::TextureStreamer &textureStreamer,
+        const framework::AssetPack &assets
+    );
+
+    void draw(framework::DrawQueue &drawQueue, glm::ivec2 selectedTile, bool useTextures) const;
 };
 
 #endif //PROG2002_CHESSBOARD_H
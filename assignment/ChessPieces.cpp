@@ -1,77 +1,59 @@
 #include "ChessPieces.h"
 #include "framework/geometry.h"
+#include "framework/ShaderSource.h"
+#include "framework/Sampler.h"
 #include "constants.h"
-#include <regex>
 
-std::string vertexShaderSource() {
-    // language=glsl
-    std::string shader = R"(
-        #version 450 core
-
-        layout(location = 0) in vec3 position;
-
-        out VertexData {
-            vec3 position;
-            vec3 texture_coordinates;
-            vec4 color;
-        } vertex_data;
-
-        uniform mat4 projection;
-        uniform mat4 view;
-        uniform mat4 model;
-
-        uniform ivec2 selected_tile;
-        uniform ivec2 piece_being_moved;
-
-        struct InstanceData {
-            ivec2 position;
-            vec4 color;
-        };
-
-        layout(std140) uniform InstanceBuffer {
-            InstanceData instances[BOARD_PIECES];
-        };
-
-        const vec4 GREEN = vec4(0, 1, 0, 1);
-        const vec4 YELLOW = vec4(1, 1, 0, 1);
+// language=glsl
+const std::string vertexShaderSource = R"(
+    #version 450 core
+    #include "framework/frame_uniforms.glsl"
 
-        void main() {
-            InstanceData instance_data = instances[gl_InstanceID];
+    layout(location = 0) in vec3 position;
+    layout(location = 1) in ivec2 instance_position;
+    layout(location = 2) in vec4 instance_color;
 
-            vertex_data.position = (model * vec4(position, 1.0)).xyz;
-            vertex_data.texture_coordinates = position;
+    out VertexData {
+        vec3 position;
+        vec3 texture_coordinates;
+        vec4 color;
+    } vertex_data;
 
-            ivec2 piece_position = instance_data.position;
+    uniform mat4 model;
 
-            if (piece_position == piece_being_moved) {
-                vertex_data.color = YELLOW;
-            } else if (piece_position == selected_tile) {
-                vertex_data.color = GREEN;
-            } else {
-                vertex_data.color = instance_data.color;
-            }
+    uniform ivec2 selected_tile;
+    uniform ivec2 piece_being_moved;
 
-            float offset = 4. / (float(BOARD_SIZE));
+    const vec4 GREEN = vec4(0, 1, 0, 1);
+    const vec4 YELLOW = vec4(1, 1, 0, 1);
 
-            // Position of {0, 0} on the board
-            vec2 piece_origin = vec2(-2 + offset / 2., 2 - offset / 2.);
+    void main() {
+        vertex_data.position = (model * vec4(position, 1.0)).xyz;
+        vertex_data.texture_coordinates = position;
 
-            // Offset from {0, 0}
-            vec2 piece_offset = vec2(offset, -offset) * piece_position;
+        ivec2 piece_position = instance_position;
 
-            gl_Position =
-                projection * view * model * vec4(position.xyz, 1.0) + // Mesh position
-                projection * view * vec4(piece_origin + piece_offset, 0, 1); // Instance position
+        if (piece_position == piece_being_moved) {
+            vertex_data.color = YELLOW;
+        } else if (piece_position == selected_tile) {
+            vertex_data.color = GREEN;
+        } else {
+            vertex_data.color = instance_color;
         }
-    )";
 
-    // Replace constants with actual value
-    shader = std::regex_replace(shader, std::regex("BOARD_SIZE"), std::to_string(BOARD_SIZE));
-    shader = std::regex_replace(shader, std::regex("BOARD_PIECES"), std::to_string(BOARD_PIECES));
+        float offset = 4. / (float(BOARD_SIZE));
 
-    return shader;
-}
+        // Position of {0, 0} on the board
+        vec2 piece_origin = vec2(-2 + offset / 2., 2 - offset / 2.);
+
+        // Offset from {0, 0}
+        vec2 piece_offset = vec2(offset, -offset) * piece_position;
 
+        gl_Position =
+            frame.view_projection * model * vec4(position.xyz, 1.0) + // Mesh position
+            frame.view_projection * vec4(piece_origin + piece_offset, 0, 1); // Instance position
+    }
+)";
 
 // language=glsl
 const std::string fragmentShaderSource = R"(
@@ -104,8 +86,25 @@ static glm::mat4 modelMatrix() {
     return modelMatrix;
 }
 
-ChessPieces ChessPieces::create(const std::vector<InstanceData> &pieces) {
-    auto cubeShader = std::make_shared<framework::Shader>(vertexShaderSource(), fragmentShaderSource);
+static framework::ShaderDefines shaderDefines() {
+    return {{"BOARD_SIZE", BOARD_SIZE}};
+}
+
+framework::ShaderVariants ChessPieces::shaderVariants() {
+    return {vertexShaderSource, fragmentShaderSource};
+}
+
+framework::PendingShader &ChessPieces::compileShader(framework::ShaderVariants &shaders) {
+    return shaders.compile(shaderDefines());
+}
+
+ChessPieces ChessPieces::create(
+    const std::vector<InstanceData> &pieces,
+    framework::ShaderVariants &shaders,
+    framework::TextureStreamer &textureStreamer,
+    const framework::AssetPack &assets
+) {
+    auto cubeShader = shaders.variant(shaderDefines());
     cubeShader->uploadUniformMatrix4("model", modelMatrix());
 
     auto cubeVertices =
@@ -117,6 +116,8 @@ ChessPieces ChessPieces::create(const std::vector<InstanceData> &pieces) {
 
     auto cubeIndices = framework::unitCube::indices;
 
+    auto instanceBuffer = framework::VertexBuffer<InstanceData>(pieces, framework::BufferUsage::Dynamic);
+
     auto vertexArray = framework::VertexArray(
         cubeShader,
         {
@@ -125,36 +126,42 @@ ChessPieces ChessPieces::create(const std::vector<InstanceData> &pieces) {
         framework::VertexBuffer<ChessPieces::Vertex>({cubeVertices.begin(), cubeVertices.end()}),
         framework::IndexBuffer(cubeIndices)
     );
+    vertexArray.setInstanceBuffer(
+        instanceBuffer,
+        {
+            {.type = GL_INT, .size = 2, .offset = offsetof(InstanceData, position), .isInteger = true},
+            {.type = GL_FLOAT, .size = 4, .offset = offsetof(InstanceData, color)},
+        }
+    );
 
-    auto texture = framework::loadCubemap(RESOURCES_DIR + std::string("textures/cube_texture.png"));
-
-    auto instanceBuffer = framework::UniformBuffer<InstanceData>::create(pieces);
+    auto texture = textureStreamer.load(
+        assets.asset("textures/cube_texture.png"),
+        framework::TextureType::Cubemap
+    );
 
     return {
+        .instanceBuffer = std::move(instanceBuffer),
         .vertexArray = std::move(vertexArray),
-        .texture = std::move(texture),
-        .instanceBuffer = std::move(instanceBuffer)
+        .texture = std::move(texture)
     };
 }
 
-void ChessPieces::updatePieces(const std::vector<InstanceData> &pieces) const {
-    instanceBuffer.updateData(pieces);
+void ChessPieces::updatePieces(const std::vector<InstanceData> &pieces) {
+    instanceBuffer.updateVertices(pieces);
 }
 
 void ChessPieces::draw(
+    framework::DrawQueue &drawQueue,
     glm::ivec2 selectedTile,
     std::optional<glm::ivec2> pieceBeingMoved,
-    bool useTextures,
-    const framework::Camera &camera
+    bool useTextures
 ) const {
-    vertexArray.shader->uploadUniformInt2("selected_tile", selectedTile);
-    vertexArray.shader->uploadUniformInt2("piece_being_moved", pieceBeingMoved.value_or(glm::ivec2(-1, -1)));
-
-    vertexArray.shader->uploadUniformBuffer("InstanceBuffer", 0, instanceBuffer);
-    vertexArray.shader->uploadUniformBool1("use_textures", useTextures);
-    vertexArray.shader->uploadUniformMatrix4("projection", camera.projectionMatrix);
-    vertexArray.shader->uploadUniformMatrix4("view", camera.viewMatrix());
-
-    texture.bind();
-    vertexArray.drawInstanced(BOARD_PIECES);
+    auto drawCommand = vertexArray.drawCommand(instanceBuffer.verticesAmount)
+        .withUniform("selected_tile", selectedTile)
+        .withUniform("piece_being_moved", pieceBeingMoved.value_or(glm::ivec2(-1, -1)))
+        .withUniform("use_textures", useTextures)
+        .withTexture(0, *texture, framework::samplerCache().sampler({.wrapping = framework::Wrapping::ClampToEdge}))
+        .withLabel("ChessPieces");
+
+    drawQueue.submit(std::move(drawCommand));
 }
\ No newline at end of file
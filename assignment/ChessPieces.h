@@ -3,8 +3,11 @@
 
 #include "glm/vec3.hpp"
 #include "framework/VertexArray.h"
-#include "framework/Texture.h"
-#include "framework/Camera.h"
+#include "framework/TextureStreamer.h"
+#include "framework/VertexBuffer.h"
+#include "framework/DrawQueue.h"
+#include "framework/ShaderSource.h"
+#include "framework/AssetPack.h"
 
 struct ChessPieces {
     struct Vertex {
@@ -12,27 +15,44 @@ struct ChessPieces {
         glm::vec3 position;
     };
 
-    // Needs to comply with std140, so each data needs to be 16 bytes long
+    /// Per-instance vertex attributes, tightly packed
     struct InstanceData {
-        glm::ivec2 position; // 8 bytes
-        glm::vec2 _padding1; // 8 of padding
+        /// Tile of the piece
+        glm::ivec2 position;
 
-        glm::vec4 color; // 16 bytes
+        /// Team color of the piece
+        glm::vec4 color;
     };
 
+    framework::VertexBuffer<InstanceData> instanceBuffer;
     const framework::VertexArray<Vertex> vertexArray;
-    const framework::Texture texture;
-    const framework::UniformBuffer<InstanceData> instanceBuffer;
+    /// Placeholder until streamed in
+    const std::shared_ptr<framework::Texture> texture;
 
-    static ChessPieces create(const std::vector<InstanceData> &pieces);
+    /**
+     * Variants of the shader, one program per define set
+     */
+    static framework::ShaderVariants shaderVariants();
 
-    void updatePieces(const std::vector<InstanceData> &pieces) const;
+    /**
+     * Start compiling the variant for the board, so it can compile while other work is done
+     */
+    static framework::PendingShader &compileShader(framework::ShaderVariants &shaders);
+
+    static ChessPieces create(
+        const std::vector<InstanceData> &pieces,
+        framework::ShaderVariants &shaders,
+        framework::TextureStreamer &textureStreamer,
+        const framework::AssetPack &assets
+    );
+
+    void updatePieces(const std::vector<InstanceData> &pieces);
 
     void draw(
+        framework::DrawQueue &drawQueue,
         glm::ivec2 selectedTile,
         std::optional<glm::ivec2> pieceBeingMoved,
-        bool useTextures,
-        const framework::Camera &
+        bool useTextures
     ) const;
 };
 
@@ -0,0 +1,248 @@
+#include "ChessScene.h"
+#include <array>
+#include <future>
+#include "glm/ext/matrix_transform.hpp"
+#include "framework/geometry.h"
+#include "framework/ShaderSource.h"
+#include "framework/GpuProfiler.h"
+#include "constants.h"
+
+// language=glsl
+const std::string vertexShaderSource = R"(
+    #version 450 core
+    #include "framework/multi_draw.glsl"
+    #include "framework/frame_uniforms.glsl"
+
+    layout(location = 0) in vec3 position;
+    layout(location = 1) in vec2 texture_coordinates;
+
+    struct DrawData {
+        uint material;
+        uint is_piece;
+    };
+
+    struct Piece {
+        ivec2 position;
+        ivec2 padding;
+        vec4 color;
+    };
+
+    layout(std430, binding = 0) readonly buffer DrawDataBuffer {
+        DrawData draws[];
+    };
+
+    layout(std430, binding = 2) readonly buffer PieceBuffer {
+        Piece pieces[];
+    };
+
+    out VertexData {
+        vec3 object_position;
+        vec2 texture_coordinates;
+        vec4 color;
+        flat uint material;
+        flat uint is_piece;
+    } vertex_data;
+
+    uniform mat4 piece_model;
+    uniform ivec2 selected_tile;
+    uniform ivec2 piece_being_moved;
+
+    const vec4 GREEN = vec4(0, 1, 0, 1);
+    const vec4 YELLOW = vec4(1, 1, 0, 1);
+
+    void main() {
+        DrawData draw_data = draws[DRAW_ID];
+
+        vertex_data.object_position = position;
+        vertex_data.texture_coordinates = texture_coordinates;
+        vertex_data.material = draw_data.material;
+        vertex_data.is_piece = draw_data.is_piece;
+
+        if (draw_data.is_piece == 0) {
+            vertex_data.color = vec4(0);
+            gl_Position = frame.view_projection * vec4(position, 1.0);
+            return;
+        }
+
+        Piece piece = pieces[gl_InstanceID];
+
+        if (piece.position == piece_being_moved) {
+            vertex_data.color = YELLOW;
+        } else if (piece.position == selected_tile) {
+            vertex_data.color = GREEN;
+        } else {
+            vertex_data.color = piece.color;
+        }
+
+        // Same placement as the instanced pieces of `ChessPieces`
+        float offset = 4. / (float(BOARD_SIZE));
+        vec2 piece_origin = vec2(-2 + offset / 2., 2 - offset / 2.);
+        vec2 piece_offset = vec2(offset, -offset) * piece.position;
+
+        gl_Position =
+            frame.view_projection * piece_model * vec4(position, 1.0) +
+            frame.view_projection * vec4(piece_origin + piece_offset, 0, 1);
+    }
+)";
+
+// language=glsl
+const std::string fragmentShaderSource = R"(
+    #version 450 core
+    #include "framework/materials.glsl"
+
+    in VertexData {
+        vec3 object_position;
+        vec2 texture_coordinates;
+        vec4 color;
+        flat uint material;
+        flat uint is_piece;
+    } vertex_data;
+
+    out vec4 color;
+
+    uniform bool use_textures;
+    uniform ivec2 selected_tile;
+
+    const vec4 WHITE = vec4(1, 1, 1, 1);
+    const vec4 BLACK = vec4(0, 0, 0, 1);
+    const vec4 GREEN = vec4(0, 1, 0, 1);
+
+    /// Coordinates on the cube face a position lies on, so every face shows the whole texture
+    vec2 cubeFaceCoordinates(vec3 position) {
+        vec3 distance = abs(position);
+
+        if (distance.x >= distance.y && distance.x >= distance.z) return position.yz * 0.5 + 0.5;
+        if (distance.y >= distance.z) return position.xz * 0.5 + 0.5;
+        return position.xy * 0.5 + 0.5;
+    }
+
+    void main() {
+        if (vertex_data.is_piece != 0) {
+            vec4 texture_color = sampleMaterial(vertex_data.material, cubeFaceCoordinates(vertex_data.object_position));
+
+            color = mix(vertex_data.color, texture_color, use_textures ? 0.5 : 0);
+            return;
+        }
+
+        ivec2 tile_index = ivec2(floor(vertex_data.texture_coordinates * BOARD_SIZE));
+
+        bool is_black = tile_index.x % 2 == tile_index.y % 2;
+        vec4 chessboard_color = tile_index == selected_tile ? GREEN : (is_black ? BLACK : WHITE);
+
+        vec4 texture_color = sampleMaterial(vertex_data.material, vertex_data.texture_coordinates);
+
+        color = mix(chessboard_color, texture_color, use_textures ? 0.7 : 0);
+    }
+)";
+
+/// Material index of each texture in the table
+enum Material : uint32_t {
+    FloorMaterial,
+    PieceMaterial
+};
+
+static std::vector<ChessScene::PieceData> pieceData(const std::vector<ChessPieces::InstanceData> &pieces) {
+    std::vector<ChessScene::PieceData> data;
+    for (auto &piece: pieces) {
+        data.push_back({.position = piece.position, .padding = {}, .color = piece.color});
+    }
+
+    return data;
+}
+
+framework::ShaderVariants ChessScene::shaderVariants() {
+    return {vertexShaderSource, fragmentShaderSource};
+}
+
+ChessScene ChessScene::create(
+    const std::vector<ChessPieces::InstanceData> &pieces,
+    framework::ShaderVariants &shaders,
+    const framework::AssetPack &assets
+) {
+    // Decode both textures at once
+    auto floorImage = std::async(std::launch::async, [&assets]() {
+        return framework::decodeImage(assets.asset("textures/floor_texture.png"));
+    });
+    auto pieceImage = std::async(std::launch::async, [&assets]() {
+        return framework::decodeImage(assets.asset("textures/cube_texture.png"));
+    });
+
+    std::array<framework::Image, 2> images;
+    images[FloorMaterial] = floorImage.get();
+    images[PieceMaterial] = pieceImage.get();
+
+    auto materials = framework::MaterialTable(images);
+
+    // The materials decide how textures are read, so they are created before the shader
+    auto defines = materials.shaderDefines();
+    defines.emplace("BOARD_SIZE", BOARD_SIZE);
+
+    auto shader = shaders.variant(defines);
+
+    auto pieceModel = glm::translate(glm::scale(glm::mat4(1.0f), glm::vec3(PIECE_SCALE)), glm::vec3(0.f, 0.f, 1.2f));
+    shader->uploadUniformMatrix4("piece_model", pieceModel);
+
+    auto batch = framework::MultiDrawBatch<Vertex, DrawData>(
+        shader,
+        {
+            {.type = GL_FLOAT, .size = 3, .offset = offsetof(Vertex, position)},
+            {.type = GL_FLOAT, .size = 2, .offset = offsetof(Vertex, textureCoordinates)},
+        }
+    );
+
+    auto boardMesh = batch.addMesh(
+        {
+            {.position = {1.f, 1.f, 0.f}, .textureCoordinates = {1.f, 0.f}},
+            {.position = {1.f, -1.f, 0.f}, .textureCoordinates = {1.f, 1.f}},
+            {.position = {-1.f, 1.f, 0.f}, .textureCoordinates = {0.f, 0.f}},
+            {.position = {-1.f, -1.f, 0.f}, .textureCoordinates = {0.f, 1.f}},
+        },
+        {0, 1, 2, 1, 3, 2}
+    );
+
+    // Piece texture coordinates are found per face in the fragment shader
+    std::vector<Vertex> cubeVertices;
+    for (auto position: framework::unitCube::vertices) {
+        cubeVertices.push_back({.position = position, .textureCoordinates = {}});
+    }
+    auto pieceMesh = batch.addMesh(cubeVertices, framework::unitCube::indices);
+
+    batch.build();
+
+    ChessScene scene = {
+        .materials = std::move(materials),
+        .shader = std::move(shader),
+        .batch = std::move(batch),
+        .pieceBuffer = framework::ShaderStorageBuffer<PieceData>::create(pieceData(pieces)),
+        .boardMesh = boardMesh,
+        .pieceMesh = pieceMesh
+    };
+    scene.updateDraws();
+
+    return scene;
+}
+
+void ChessScene::updatePieces(const std::vector<ChessPieces::InstanceData> &pieces) {
+    auto hasChangedAmount = pieces.size() != pieceBuffer.elements.size();
+
+    pieceBuffer.updateData(pieceData(pieces));
+    if (hasChangedAmount) updateDraws();
+}
+
+void ChessScene::updateDraws() {
+    batch.clearDraws();
+    batch.addDraw(boardMesh, {.material = FloorMaterial, .isPiece = 0});
+    batch.addDraw(pieceMesh, {.material = PieceMaterial, .isPiece = 1}, pieceBuffer.elements.size());
+}
+
+void ChessScene::draw(glm::ivec2 selectedTile, std::optional<glm::ivec2> pieceBeingMoved, bool useTextures) {
+    framework::GpuProfiler::Scope scope(framework::gpuProfiler(), "ChessScene");
+
+    shader->uploadUniformInt2("selected_tile", selectedTile);
+    shader->uploadUniformInt2("piece_being_moved", pieceBeingMoved.value_or(glm::ivec2(-1, -1)));
+    shader->uploadUniformBool1("use_textures", useTextures);
+
+    materials.bind();
+    pieceBuffer.bind(2);
+    batch.draw();
+}
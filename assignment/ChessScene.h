@@ -0,0 +1,72 @@
+#ifndef PROG2002_CHESSSCENE_H
+#define PROG2002_CHESSSCENE_H
+
+#include <optional>
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "framework/MultiDrawBatch.h"
+#include "framework/MaterialTable.h"
+#include "framework/ShaderStorageBuffer.h"
+#include "framework/AssetPack.h"
+#include "framework/ShaderSource.h"
+#include "ChessPieces.h"
+
+/**
+ * The board and every piece drawn with a single multi-draw call, each draw picking its texture from a
+ * `MaterialTable` instead of binding its own texture
+ */
+struct ChessScene {
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec2 textureCoordinates;
+    };
+
+    /// Per-draw data, complies with std430
+    struct DrawData {
+        uint32_t material;
+
+        /// Whether the draw is the instanced pieces rather than the board
+        uint32_t isPiece;
+    };
+
+    /// Per-piece data, padded to comply with std430
+    struct PieceData {
+        glm::ivec2 position;
+        glm::ivec2 padding;
+        glm::vec4 color;
+    };
+
+    framework::MaterialTable materials;
+    std::shared_ptr<framework::Shader> shader;
+    framework::MultiDrawBatch<Vertex, DrawData> batch;
+    framework::ShaderStorageBuffer<PieceData> pieceBuffer;
+
+    framework::MultiDrawBatch<Vertex, DrawData>::Mesh boardMesh;
+    framework::MultiDrawBatch<Vertex, DrawData>::Mesh pieceMesh;
+
+    /**
+     * Variants of the shader, one program per define set, which the material table picks between
+     */
+    static framework::ShaderVariants shaderVariants();
+
+    /**
+     * Decode the board and piece textures into a material table, and build the shared meshes
+     */
+    static ChessScene create(
+        const std::vector<ChessPieces::InstanceData> &pieces,
+        framework::ShaderVariants &shaders,
+        const framework::AssetPack &assets
+    );
+
+    void updatePieces(const std::vector<ChessPieces::InstanceData> &pieces);
+
+    /**
+     * Replace the draws of the batch, only needed when the amount of pieces changes
+     */
+    void updateDraws();
+
+    void draw(glm::ivec2 selectedTile, std::optional<glm::ivec2> pieceBeingMoved, bool useTextures);
+};
+
+#endif //PROG2002_CHESSSCENE_H
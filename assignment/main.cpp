@@ -2,9 +2,22 @@
 #include "stb_image.h"
 #include "framework/window.h"
 #include "framework/Camera.h"
+#include "framework/FrameStats.h"
+#include "framework/FrameStatsOverlay.h"
+#include "framework/FrameUniforms.h"
+#include "framework/DrawQueue.h"
+#include "framework/ShaderCache.h"
+#include "framework/AssetPack.h"
+#include "framework/GpuProfiler.h"
+#include "framework/GameLoop.h"
 #include "ChessBoard.h"
 #include "ChessPieces.h"
+#include "ChessScene.h"
 #include "constants.h"
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
 
 /// Initial chess pieces
 static std::vector<ChessPieces::InstanceData> initialChessPieces() {
@@ -33,6 +46,88 @@ static std::vector<ChessPieces::InstanceData> initialChessPieces() {
     return pieces;
 }
 
+/// Pieces of `boards` boards laid out in a square grid next to each other, used to stress test instancing
+static std::vector<ChessPieces::InstanceData> stressChessPieces(int boards) {
+    auto boardPieces = initialChessPieces();
+    auto columns = (int) glm::ceil(glm::sqrt((float) boards));
+
+    std::vector<ChessPieces::InstanceData> pieces;
+    pieces.reserve(boards * boardPieces.size());
+
+    for (int board = 0; board < boards; ++board) {
+        glm::ivec2 boardOffset = glm::ivec2(board % columns, board / columns) * BOARD_SIZE;
+
+        for (auto piece: boardPieces) {
+            piece.position += boardOffset;
+            pieces.push_back(piece);
+        }
+    }
+
+    return pieces;
+}
+
+/**
+ * Amount of boards given with `--stress <boards>`, 0 if not stress testing. Exits with a usage error unless it is a
+ * positive whole number.
+ */
+static int stressBoards(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) != "--stress") continue;
+
+        auto value = i + 1 < argc ? argv[i + 1] : nullptr;
+        int boards = 0;
+        auto end = value != nullptr ? value + std::strlen(value) : nullptr;
+        auto [parsedEnd, error] = value != nullptr ? std::from_chars(value, end, boards) : std::from_chars_result{};
+
+        if (value == nullptr || error != std::errc() || parsedEnd != end || boards <= 0) {
+            std::cerr << "--stress needs a positive whole number of boards, got "
+                      << (value != nullptr ? value : "nothing") << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        return boards;
+    }
+
+    return 0;
+}
+
+/// Whether `--single-draw` was given, to draw the board and pieces with one call
+static bool isSingleDraw(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--single-draw") return true;
+    }
+
+    return false;
+}
+
+/// Whether `--profile` was given, to time every frame and print where it went on exit
+static bool isProfiling(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--profile") return true;
+    }
+
+    return false;
+}
+
+/**
+ * File given with `--stats-csv <path>` to log the counters of every frame to, empty if not logging. Exits with a
+ * usage error if the path is missing.
+ */
+static std::string frameStatsCsvPath(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) != "--stats-csv") continue;
+
+        if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+            std::cerr << "--stats-csv needs a path to write the frame counters to" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        return argv[i + 1];
+    }
+
+    return "";
+}
+
 /// Find camera position that orbits around origin given `angle` and `zoom`,
 glm::vec3 calculateCameraPosition(float angle, float zoom) {
     glm::vec3 position = {4.f * glm::cos(angle) * zoom, 4.f * glm::sin(angle) * zoom, 1.8f * zoom};
@@ -47,6 +142,10 @@ struct GameState {
     /// Camera zoom
     float cameraZoom;
 
+    /// Camera angle and zoom before the last update, rendering interpolates from these
+    float previousCameraAngle;
+    float previousCameraZoom;
+
     /// Whether to render with textures or not
     bool useTextures;
 
@@ -56,12 +155,15 @@ struct GameState {
     /// The position of the piece that is currently being moved, empty if not moving one
     std::optional<glm::ivec2> pieceBeingMoved;
 
-    /// Position and color of each chess piece, can be directly loaded into a UniformBuffer
+    /// Position and color of each chess piece, can be directly loaded into the instance buffer
     std::vector<ChessPieces::InstanceData> pieces;
 
-    /// Whether pieces has been changed, will need to upload to the UniformBuffer again
+    /// Whether pieces has been changed, will need to upload to the instance buffer again
     bool piecesHasUpdated;
 
+    /// Whether to show the counters of the last frame on screen
+    bool showFrameStats;
+
     /// Handle key input from GLFW
     void handleKeyInput(int key, int action) {
         if (action != GLFW_PRESS) return;
@@ -72,6 +174,16 @@ struct GameState {
                 useTextures = !useTextures;
                 break;
 
+                // Print statistics of the last frame
+            case GLFW_KEY_F1:
+                std::cout << framework::previousFrameStats() << std::endl;
+                break;
+
+                // Toggle the frame statistics overlay
+            case GLFW_KEY_F2:
+                showFrameStats = !showFrameStats;
+                break;
+
                 // Tile selection move
             case GLFW_KEY_LEFT:
                 if (selectedTile.x > 0) selectedTile.x -= 1;
@@ -127,8 +239,11 @@ struct GameState {
         }
     }
 
-    /// Game loop update
+    /// Advance the simulation by one fixed step of `deltaTime` seconds
     void update(GLFWwindow *window, float deltaTime) {
+        previousCameraAngle = cameraAngle;
+        previousCameraZoom = cameraZoom;
+
         if (glfwGetKey(window, GLFW_KEY_L)) {
             cameraAngle += CAMERA_SENSITIVITY * deltaTime;
         }
@@ -148,24 +263,34 @@ struct GameState {
         }
     };
 
+    /// Camera position between the last two updates, `alpha` of the way from the previous one
+    [[nodiscard]] glm::vec3 interpolatedCameraPosition(float alpha) const {
+        return calculateCameraPosition(
+            glm::mix(previousCameraAngle, cameraAngle, alpha),
+            glm::mix(previousCameraZoom, cameraZoom, alpha)
+        );
+    }
+
 };
 
 
-int main() {
-    int width = 800;
-    int height = 600;
+/**
+ * Run the game until its window closes. Every OpenGL object of the game is owned in here, so all of them are deleted
+ * on return, while the context is still alive and before the window is destroyed.
+ */
+static void runGame(GLFWwindow *window, int width, int height, int boards, int argc, char *argv[]) {
     float aspectRatio = (float) width / (float) height;
 
-    auto window = framework::createWindow(width, height, "Assignment");
-
     // Game state, only static so that it can be used in glfwSetKeyCallback
     static GameState gameState = {
         .cameraAngle = glm::pi<float>() * 1.5f,
         .cameraZoom = 1.f,
+        .previousCameraAngle = glm::pi<float>() * 1.5f,
+        .previousCameraZoom = 1.f,
         .useTextures = true,
         .selectedTile = {0, 0},
         .pieceBeingMoved = {},
-        .pieces = initialChessPieces()
+        .pieces = boards > 0 ? stressChessPieces(boards) : initialChessPieces()
     };
 
     // Camera
@@ -175,13 +300,48 @@ int main() {
 
     static auto camera = framework::Camera::createPerspective(45.f, aspectRatio, position, target, up);
 
+    auto frameUniforms = framework::FrameUniformBuffer::create();
+    framework::DrawQueue drawQueue;
+
+    // Start every shader before waiting on any, so they compile in parallel
+    auto chessboardShader = ChessBoard::compileShader();
+    auto chessPiecesShaders = ChessPieces::shaderVariants();
+    auto &chessPiecesShader = ChessPieces::compileShader(chessPiecesShaders);
+
+    // Every resource is read in place from one mapped file, declared first so it outlives the texture streamer
+    framework::AssetPack assets(ASSET_PACK_PATH);
+
+    // Textures are decoded and uploaded in the background
+    auto texturesStartTime = glfwGetTime();
+    bool hasStreamedTextures = false;
+    framework::TextureStreamer textureStreamer(window);
+
     // Objects
-    auto chessboard = ChessBoard::create();
-    auto chessPieces = ChessPieces::create(gameState.pieces);
+    auto chessboard = ChessBoard::create(chessboardShader, textureStreamer, assets);
+    auto chessPieces = ChessPieces::create(gameState.pieces, chessPiecesShaders, textureStreamer, assets);
 
-    // Time
-    double lastFrameTime;
-    float deltaTime;
+    auto chessSceneShaders = ChessScene::shaderVariants();
+    std::optional<ChessScene> chessScene;
+    if (isSingleDraw(argc, argv)) {
+        chessScene.emplace(ChessScene::create(gameState.pieces, chessSceneShaders, assets));
+
+        std::cout << "Single draw materials: " << chessScene->materials.memory()
+                  << (chessScene->materials.isBindless() ? ", bindless" : ", texture array") << std::endl;
+    }
+
+    std::cout << "Chessboard shader " << chessboardShader.timing() << std::endl;
+    std::cout << "Chess pieces shader " << chessPiecesShader.timing() << std::endl;
+
+    // Run twice to see the startup time with a warm cache
+    std::cout << framework::shaderCache().cacheStats() << std::endl;
+
+    // Frame counters, shown with F2 and logged with `--stats-csv`
+    framework::FrameStatsOverlay frameStatsOverlay;
+    std::optional<framework::FrameStatsCsv> frameStatsCsv;
+    if (auto path = frameStatsCsvPath(argc, argv); !path.empty()) frameStatsCsv.emplace(path);
+
+    // Scope timings, only recorded with `--profile`
+    auto &profiler = framework::gpuProfiler();
 
     // Handle input
     auto handleKeyInput = [](GLFWwindow *window, int key, int scancode, int action, int mods) {
@@ -190,45 +350,107 @@ int main() {
     glfwSetKeyCallback(window, handleKeyInput);
 
     // Enable depth
-    glEnable(GL_DEPTH_TEST);
+    framework::renderState().setDepthTest(true);
 
     // Clear color
     glm::vec3 backgroundColor = {0.917f, 0.905f, 0.850f};
 
+    // Simulation runs in fixed steps, vertical sync unless `--uncapped` or `--fps <frames per second>` is given
+    framework::GameLoop gameLoop(window, framework::gameLoopSettings(argc, argv));
+
+    // Stress test reporting, timed with the frames of the game loop
+    double lastReportTime = gameLoop.frameStart();
+    int framesSinceReport = 0;
+
     // Event loop
-    while (!glfwWindowShouldClose(window)) {
-        // Set deltaTime
-        auto time = glfwGetTime();
-        deltaTime = (float) (time - lastFrameTime);
-        lastFrameTime = time;
+    while (gameLoop.beginFrame()) {
+        auto time = gameLoop.frameStart();
+
+        profiler.beginFrame();
 
         // Update
-        glfwPollEvents();
-        gameState.update(window, deltaTime);
-        camera.position = calculateCameraPosition(gameState.cameraAngle, gameState.cameraZoom);
+        profiler.beginScope("Update");
+        textureStreamer.update();
+
+        if (!hasStreamedTextures && textureStreamer.isIdle()) {
+            hasStreamedTextures = true;
+
+            std::cout << "Textures streamed in " << (time - texturesStartTime) * 1000. << " ms" << std::endl;
+            std::cout << "Chessboard texture: " << chessboard.texture->memory() << std::endl;
+            std::cout << "Chess pieces texture: " << chessPieces.texture->memory() << std::endl;
+        }
+        while (gameLoop.step()) {
+            gameState.update(window, (float) gameLoop.timeStep());
+        }
+
+        camera.position = gameState.interpolatedCameraPosition(gameLoop.alpha());
+        frameUniforms.update(camera, (float) gameLoop.time());
+        drawQueue.setCameraPosition(camera.position);
 
         if (gameState.piecesHasUpdated) {
             chessPieces.updatePieces(gameState.pieces);
+            if (chessScene) chessScene->updatePieces(gameState.pieces);
             gameState.piecesHasUpdated = false;
         }
 
+        profiler.endScope();
+
         // Background color
         glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, 1.0f);
 
         // Draw
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        chessboard.draw(gameState.selectedTile, gameState.useTextures, camera);
-        chessPieces.draw(gameState.selectedTile, gameState.pieceBeingMoved, gameState.useTextures, camera);
+        if (chessScene) {
+            chessScene->draw(gameState.selectedTile, gameState.pieceBeingMoved, gameState.useTextures);
+        } else {
+            chessboard.draw(drawQueue, gameState.selectedTile, gameState.useTextures);
+            chessPieces.draw(drawQueue, gameState.selectedTile, gameState.pieceBeingMoved, gameState.useTextures);
+        }
+        drawQueue.flush();
+
+        if (gameState.showFrameStats) frameStatsOverlay.draw(framework::previousFrameStats(), width, height);
 
         // Swap front and back buffer
-        glfwSwapBuffers(window);
+        framework::swapBuffers(window);
+        if (frameStatsCsv) frameStatsCsv->write(framework::frameStats());
+        framework::endFrameStats();
+        profiler.endFrame();
+        gameLoop.endFrame();
+
+        // Report average frame time once per second
+        framesSinceReport++;
+        if (boards > 0 && time - lastReportTime >= 1.) {
+            auto frameTime = (time - lastReportTime) / framesSinceReport;
+            std::cout << gameState.pieces.size() << " instances: " << frameTime * 1000. << " ms/frame" << std::endl;
+
+            lastReportTime = time;
+            framesSinceReport = 0;
+        }
 
         // Escape button
         bool isPressingEscape = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
         if (isPressingEscape) break;
     }
-    
-    glfwTerminate();
+
+    if (profiler.isEnabled()) std::cout << profiler << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int boards = stressBoards(argc, argv);
+
+    int width = 800;
+    int height = 600;
+
+    auto window = framework::createWindow(width, height, "Assignment", framework::windowOptions(argc, argv));
+    framework::shaderCache().enable(SHADER_CACHE_DIR);
+    if (isProfiling(argc, argv)) framework::gpuProfiler().enable();
+
+    runGame(window, width, height, boards, argc, argv);
+
+    // Sampler objects and queries have to be deleted while the context is alive
+    framework::samplerCache().clear();
+    framework::gpuProfiler().clear();
+    framework::destroyWindow(window);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
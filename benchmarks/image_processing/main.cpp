@@ -0,0 +1,114 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "framework/ImageProcessing.h"
+
+/// Size of the benchmark image, 4K UHD
+const size_t WIDTH = 3840;
+const size_t HEIGHT = 2160;
+const size_t PIXELS = WIDTH * HEIGHT;
+
+/// Amount of runs per measurement, the fastest one is reported
+const int RUNS = 20;
+
+/**
+ * Run `kernel` `RUNS` times on a fresh copy of `input`
+ * @return Fastest run in milliseconds, and the output of the last run
+ */
+static std::pair<double, std::vector<uint8_t>> measure(
+    const std::vector<uint8_t> &input,
+    size_t outputSize,
+    const std::function<void(const uint8_t *, uint8_t *)> &kernel
+) {
+    double fastest = std::numeric_limits<double>::max();
+    std::vector<uint8_t> output(outputSize);
+
+    for (int run = 0; run < RUNS; ++run) {
+        // In place kernels work on a copy of the input
+        if (outputSize == input.size()) output = input;
+
+        auto start = std::chrono::steady_clock::now();
+        kernel(input.data(), output.data());
+        auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        fastest = std::min(fastest, milliseconds.count());
+    }
+
+    return {fastest, output};
+}
+
+/**
+ * Measure `kernel` with every instruction set the CPU supports, against the scalar version
+ */
+static void compare(
+    const std::string &label,
+    const std::vector<uint8_t> &input,
+    size_t outputSize,
+    const std::function<void(const uint8_t *, uint8_t *, framework::SimdLevel)> &kernel
+) {
+    auto levels = {
+        framework::SimdLevel::Scalar,
+        framework::SimdLevel::Sse2,
+        framework::SimdLevel::Ssse3,
+        framework::SimdLevel::Avx2
+    };
+
+    double scalarMilliseconds = 0.;
+    std::vector<uint8_t> scalarOutput;
+
+    for (auto level: levels) {
+        if (level > framework::simdLevel()) break;
+
+        auto [milliseconds, output] = measure(input, outputSize, [&](const uint8_t *source, uint8_t *destination) {
+            kernel(source, destination, level);
+        });
+
+        if (level == framework::SimdLevel::Scalar) {
+            scalarMilliseconds = milliseconds;
+            scalarOutput = std::move(output);
+        } else if (output != scalarOutput) {
+            std::cout << label << " (" << framework::simdLevelName(level) << "): differs from scalar" << std::endl;
+        }
+
+        std::cout << label << " (" << framework::simdLevelName(level) << "): " << milliseconds << " ms, "
+                  << scalarMilliseconds / milliseconds << "x scalar" << std::endl;
+    }
+}
+
+/**
+ * Compares the SIMD image kernels used when loading textures against their scalar loops, on random 4K images.
+ * Kernels without a version for an instruction set run the version of the level below, so show no speedup there.
+ */
+int main() {
+    std::cout << "Best instruction set: " << framework::simdLevelName(framework::simdLevel()) << std::endl;
+
+    std::mt19937 random(2002);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    std::vector<uint8_t> rgb(PIXELS * 3);
+    std::vector<uint8_t> rgba(PIXELS * 4);
+    for (auto &value: rgb) value = byte(random);
+    for (auto &value: rgba) value = byte(random);
+
+    compare("RGB to RGBA", rgb, PIXELS * 4, [](const uint8_t *source, uint8_t *destination, auto level) {
+        framework::expandRgbToRgba(source, destination, PIXELS, level);
+    });
+
+    compare("Premultiply alpha", rgba, PIXELS * 4, [](const uint8_t *, uint8_t *pixels, auto level) {
+        framework::premultiplyAlpha(pixels, PIXELS, level);
+    });
+
+    compare("sRGB to linear", rgba, PIXELS * 4, [](const uint8_t *, uint8_t *pixels, auto level) {
+        framework::srgbToLinear(pixels, PIXELS, level);
+    });
+
+    compare("Vertical flip", rgba, PIXELS * 4, [](const uint8_t *, uint8_t *pixels, auto level) {
+        framework::flipVertically(pixels, WIDTH * 4, HEIGHT, level);
+    });
+
+    return EXIT_SUCCESS;
+}
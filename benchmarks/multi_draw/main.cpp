@@ -0,0 +1,194 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <ranges>
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "framework/window.h"
+#include "framework/geometry.h"
+#include "framework/MultiDrawBatch.h"
+
+// language=glsl
+const std::string singleDrawVertexShaderSource = R"(
+    #version 450 core
+
+    layout(location = 0) in vec3 position;
+
+    out vec4 vertex_color;
+
+    uniform vec4 offset;
+    uniform vec4 color;
+
+    void main() {
+        gl_Position = vec4(position * 0.01 + offset.xyz, 1.0);
+        vertex_color = color;
+    }
+)";
+
+// language=glsl
+const std::string multiDrawVertexShaderSource = R"(
+    #version 450 core
+)" + framework::MULTI_DRAW_GLSL + R"(
+    layout(location = 0) in vec3 position;
+
+    out vec4 vertex_color;
+
+    struct DrawData {
+        vec4 offset;
+        vec4 color;
+    };
+
+    layout(std430, binding = 0) readonly buffer DrawDataBuffer {
+        DrawData draws[];
+    };
+
+    void main() {
+        DrawData draw_data = draws[DRAW_ID];
+
+        gl_Position = vec4(position * 0.01 + draw_data.offset.xyz, 1.0);
+        vertex_color = draw_data.color;
+    }
+)";
+
+// language=glsl
+const std::string fragmentShaderSource = R"(
+    #version 450 core
+
+    in vec4 vertex_color;
+    out vec4 color;
+
+    void main() {
+        color = vertex_color;
+    }
+)";
+
+struct Vertex {
+    glm::vec3 position;
+};
+
+/// Per-draw data, complies with std430
+struct DrawData {
+    glm::vec4 offset;
+    glm::vec4 color;
+};
+
+/// Amount of distinct meshes
+const int MESHES = 16;
+
+/// Amount of objects drawn each frame
+const int OBJECTS = 4096;
+
+/// Amount of frames per measurement
+const int FRAMES = 200;
+
+/// Vertices of mesh number `meshIndex`, a cube stretched differently for every mesh
+static std::vector<Vertex> meshVertices(int meshIndex) {
+    auto stretch = glm::vec3(1.f + (float) (meshIndex % 4), 1.f + (float) (meshIndex / 4), 1.f);
+
+    auto vertices = framework::unitCube::vertices | std::views::transform([stretch](auto position) {
+        return Vertex{.position = position * stretch};
+    });
+
+    return {vertices.begin(), vertices.end()};
+}
+
+/// Per-draw data of object number `objectIndex`, laid out in a grid over the screen
+static DrawData objectData(int objectIndex) {
+    int x = objectIndex % 64;
+    int y = objectIndex / 64;
+
+    return {
+        .offset = {(float) x / 32.f - 1.f, (float) y / 32.f - 1.f, 0.f, 0.f},
+        .color = {(float) x / 64.f, (float) y / 64.f, 1.f, 1.f}
+    };
+}
+
+/**
+ * Run `drawFrame` `FRAMES` times and print the CPU time spent submitting and the total time per frame
+ */
+static void measure(const std::string &label, GLFWwindow *window, const std::function<void()> &drawFrame) {
+    glFinish();
+
+    double submitSeconds = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        auto submitStart = std::chrono::steady_clock::now();
+        drawFrame();
+        submitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - submitStart).count();
+
+        framework::swapBuffers(window);
+    }
+
+    glFinish();
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << label << ": "
+              << submitSeconds / FRAMES * 1000. << " ms submitting, "
+              << totalSeconds / FRAMES * 1000. << " ms per frame" << std::endl;
+}
+
+/**
+ * Compares drawing `OBJECTS` objects made of `MESHES` distinct meshes with one draw call per object, against one
+ * `glMultiDrawElementsIndirect` through `framework::MultiDrawBatch`.
+ */
+int main() {
+    auto window = framework::createWindow(800, 600, "Multi draw benchmark");
+    glfwSwapInterval(0);
+
+    std::vector<framework::VertexAttribute> attributes = {
+        {.type = GL_FLOAT, .size = 3, .offset = offsetof(Vertex, position)},
+    };
+
+    // One vertex array per mesh, drawn one object at a time
+    auto singleDrawShader = std::make_shared<framework::Shader>(singleDrawVertexShaderSource, fragmentShaderSource);
+    auto offsetLocation = singleDrawShader->uniformLocation("offset");
+    auto colorLocation = singleDrawShader->uniformLocation("color");
+
+    std::vector<framework::VertexArray<Vertex>> vertexArrays;
+    for (int meshIndex = 0; meshIndex < MESHES; ++meshIndex) {
+        vertexArrays.emplace_back(
+            singleDrawShader,
+            attributes,
+            framework::VertexBuffer(meshVertices(meshIndex)),
+            framework::IndexBuffer(framework::unitCube::indices)
+        );
+    }
+
+    measure("One draw per object", window, [&]() {
+        for (int objectIndex = 0; objectIndex < OBJECTS; ++objectIndex) {
+            auto data = objectData(objectIndex);
+
+            singleDrawShader->uploadUniformFloat4(offsetLocation, data.offset);
+            singleDrawShader->uploadUniformFloat4(colorLocation, data.color);
+            vertexArrays[objectIndex % MESHES].draw();
+        }
+    });
+
+    // Every mesh in shared buffers, drawn with one call
+    auto multiDrawShader = std::make_shared<framework::Shader>(multiDrawVertexShaderSource, fragmentShaderSource);
+    auto batch = framework::MultiDrawBatch<Vertex, DrawData>(multiDrawShader, attributes);
+
+    std::vector<framework::MultiDrawBatch<Vertex, DrawData>::Mesh> meshes;
+    for (int meshIndex = 0; meshIndex < MESHES; ++meshIndex) {
+        meshes.push_back(batch.addMesh(meshVertices(meshIndex), framework::unitCube::indices));
+    }
+    batch.build();
+
+    measure("MultiDrawBatch", window, [&]() {
+        batch.clearDraws();
+
+        for (int objectIndex = 0; objectIndex < OBJECTS; ++objectIndex) {
+            batch.addDraw(meshes[objectIndex % MESHES], objectData(objectIndex));
+        }
+
+        batch.draw();
+    });
+
+    framework::destroyWindow(window);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "framework/window.h"
+#include "framework/VertexArray.h"
+#include "framework/Texture.h"
+
+// language=glsl
+const std::string vertexShaderSource = R"(
+    #version 450 core
+
+    layout(location = 0) in vec2 position;
+
+    out vec2 texture_coordinates;
+
+    uniform float tiling;
+
+    void main() {
+        gl_Position = vec4(position, 0.0, 1.0);
+        texture_coordinates = (position * 0.5 + 0.5) * tiling;
+    }
+)";
+
+// language=glsl
+const std::string fragmentShaderSource = R"(
+    #version 450 core
+
+    in vec2 texture_coordinates;
+    out vec4 color;
+
+    layout(binding = 0) uniform sampler2D texture_sampler;
+
+    void main() {
+        color = texture(texture_sampler, texture_coordinates);
+    }
+)";
+
+struct Vertex {
+    glm::vec2 position;
+};
+
+/// How many times the texture repeats over the screen, so that it is heavily minified
+const float TILING = 64.f;
+
+/// Full screen quads drawn per frame, so that sampling dominates the frame time
+const int LAYERS = 16;
+
+/// Amount of frames per measurement
+const int FRAMES = 200;
+
+/**
+ * Load the benchmark texture with `filtering` and `mipmaps`, printing how long that took
+ */
+static framework::Texture loadBenchmarkTexture(
+    const std::string &label,
+    framework::Filtering filtering,
+    framework::Mipmaps mipmaps = framework::Mipmaps::Gpu
+) {
+    auto start = std::chrono::steady_clock::now();
+
+    auto texture = framework::loadTexture(
+        TEXTURE_PATH,
+        filtering,
+        framework::Wrapping::Repeat,
+        mipmaps
+    );
+    glFinish();
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << label << ": loaded in " << milliseconds << " ms, " << texture.memory() << std::endl;
+
+    return texture;
+}
+
+/**
+ * Draw `LAYERS` minified quads `FRAMES` times and print the time per frame
+ */
+static void measure(
+    const std::string &label,
+    GLFWwindow *window,
+    const framework::VertexArray<Vertex> &quad,
+    const framework::Texture &texture
+) {
+    glFinish();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        for (int layer = 0; layer < LAYERS; ++layer) {
+            quad.drawCommand().withTexture(0, texture).issue();
+        }
+
+        framework::swapBuffers(window);
+    }
+
+    glFinish();
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << label << ": " << totalSeconds / FRAMES * 1000. << " ms per frame" << std::endl;
+}
+
+/**
+ * Compares sampling a texture repeated `TILING` times over the screen without mip levels, against the full mip chain
+ * generated on the GPU and on the CPU. Without mip levels neighbouring fragments read texels far apart, which misses
+ * the texture cache on every fetch.
+ */
+int main() {
+    auto window = framework::createWindow(800, 600, "Texture minification benchmark");
+    glfwSwapInterval(0);
+
+    auto shader = std::make_shared<framework::Shader>(vertexShaderSource, fragmentShaderSource);
+    shader->uploadUniformFloat1("tiling", TILING);
+
+    auto quad = framework::VertexArray<Vertex>(
+        shader,
+        {
+            {.type = GL_FLOAT, .size = 2, .offset = offsetof(Vertex, position)},
+        },
+        framework::VertexBuffer<Vertex>({{{-1.f, -1.f}}, {{1.f, -1.f}}, {{1.f, 1.f}}, {{-1.f, 1.f}}}),
+        framework::IndexBuffer({0, 1, 2, 0, 2, 3})
+    );
+
+    auto singleLevel = loadBenchmarkTexture("Single level", framework::Filtering::Linear);
+    auto gpuMipmaps = loadBenchmarkTexture("GPU mipmaps", framework::Filtering::LinearMipmap);
+    auto boxMipmaps = loadBenchmarkTexture("CPU box mipmaps", framework::Filtering::LinearMipmap, framework::Mipmaps::CpuBox);
+    auto kaiserMipmaps = loadBenchmarkTexture(
+        "CPU Kaiser mipmaps",
+        framework::Filtering::LinearMipmap,
+        framework::Mipmaps::CpuKaiser
+    );
+    std::cout << std::endl;
+
+    measure("Single level", window, quad, singleLevel);
+    measure("GPU mipmaps", window, quad, gpuMipmaps);
+    measure("CPU box mipmaps", window, quad, boxMipmaps);
+    measure("CPU Kaiser mipmaps", window, quad, kaiserMipmaps);
+
+    framework::destroyWindow(window);
+
+    return EXIT_SUCCESS;
+}
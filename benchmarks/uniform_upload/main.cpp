@@ -0,0 +1,116 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "framework/window.h"
+#include "framework/Shader.h"
+
+// language=glsl
+const std::string vertexShaderSource = R"(
+    #version 450 core
+
+    layout(location = 0) in vec3 position;
+
+    uniform mat4 projection;
+    uniform mat4 view;
+    uniform mat4 model;
+
+    void main() {
+        gl_Position = projection * view * model * vec4(position, 1.0);
+    }
+)";
+
+// language=glsl
+const std::string fragmentShaderSource = R"(
+    #version 450 core
+
+    out vec4 color;
+
+    uniform bool use_textures;
+    uniform ivec2 selected_tile;
+    uniform vec4 tint;
+
+    void main() {
+        color = use_textures ? tint : vec4(selected_tile, 0, 1);
+    }
+)";
+
+/// Amount of frames simulated per measurement
+const int FRAMES = 20000;
+
+/// Uniforms uploaded per frame, same amount as `ChessBoard::draw` and `ChessPieces::draw` combined
+const int UPLOADS_PER_FRAME = 6;
+
+/**
+ * Run `uploadFrame` `FRAMES` times and print how many uniform uploads per second it achieved
+ */
+static void measure(const std::string &label, const std::function<void(int)> &uploadFrame) {
+    glFinish();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        uploadFrame(frame);
+    }
+
+    glFinish();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double uploadsPerSecond = (double) (FRAMES * UPLOADS_PER_FRAME) / seconds;
+
+    std::cout << label << ": " << (uint64_t) uploadsPerSecond << " uploads/s" << std::endl;
+}
+
+/**
+ * Compares the cost of uniform uploads when looking up locations through the driver on every upload (the old
+ * behaviour), through the name table reflected by `framework::Shader`, and through precomputed
+ * `framework::UniformLocation` handles.
+ *
+ * Run with `LIBGL_ALWAYS_SOFTWARE=1` to measure on Mesa's software rasterizer.
+ */
+int main() {
+    auto window = framework::createWindow(64, 64, "Uniform upload benchmark");
+    auto shader = framework::Shader(vertexShaderSource, fragmentShaderSource);
+
+    glm::mat4 matrix(1.f);
+
+    measure("glGetUniformLocation per upload", [&](int frame) {
+        glProgramUniformMatrix4fv(shader.id, glGetUniformLocation(shader.id, "projection"), 1, false, &matrix[0][0]);
+        glProgramUniformMatrix4fv(shader.id, glGetUniformLocation(shader.id, "view"), 1, false, &matrix[0][0]);
+        glProgramUniformMatrix4fv(shader.id, glGetUniformLocation(shader.id, "model"), 1, false, &matrix[0][0]);
+        glProgramUniform1i(shader.id, glGetUniformLocation(shader.id, "use_textures"), frame % 2);
+        glProgramUniform2i(shader.id, glGetUniformLocation(shader.id, "selected_tile"), frame, frame);
+        glProgramUniform4f(shader.id, glGetUniformLocation(shader.id, "tint"), 1.f, 1.f, 1.f, 1.f);
+    });
+
+    measure("Name lookup in reflected table", [&](int frame) {
+        shader.uploadUniformMatrix4("projection", matrix);
+        shader.uploadUniformMatrix4("view", matrix);
+        shader.uploadUniformMatrix4("model", matrix);
+        shader.uploadUniformBool1("use_textures", frame % 2);
+        shader.uploadUniformInt2("selected_tile", {frame, frame});
+        shader.uploadUniformFloat4("tint", {1.f, 1.f, 1.f, 1.f});
+    });
+
+    auto projection = shader.uniformLocation("projection");
+    auto view = shader.uniformLocation("view");
+    auto model = shader.uniformLocation("model");
+    auto useTextures = shader.uniformLocation("use_textures");
+    auto selectedTile = shader.uniformLocation("selected_tile");
+    auto tint = shader.uniformLocation("tint");
+
+    measure("Precomputed UniformLocation", [&](int frame) {
+        shader.uploadUniformMatrix4(projection, matrix);
+        shader.uploadUniformMatrix4(view, matrix);
+        shader.uploadUniformMatrix4(model, matrix);
+        shader.uploadUniformBool1(useTextures, frame % 2);
+        shader.uploadUniformInt2(selectedTile, {frame, frame});
+        shader.uploadUniformFloat4(tint, {1.f, 1.f, 1.f, 1.f});
+    });
+
+    framework::destroyWindow(window);
+
+    return EXIT_SUCCESS;
+}
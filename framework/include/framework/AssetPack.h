@@ -0,0 +1,96 @@
+#ifndef PROG2002_ASSETPACK_H
+#define PROG2002_ASSETPACK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace framework {
+    /**
+     * An entry of the pack index
+     */
+    struct AssetPackEntry {
+        /// Offset of the asset from the start of the pack, a multiple of `ASSET_PACK_ALIGNMENT`
+        uint64_t offset;
+
+        uint64_t size;
+
+        /// Offset of the name from the start of the pack, names are not null terminated
+        uint64_t nameOffset;
+
+        uint64_t nameSize;
+    };
+
+    /// Alignment of every asset in a pack, so any asset can be read in place as any type
+    const uint64_t ASSET_PACK_ALIGNMENT = 64;
+
+    /**
+     * Many asset files in one file, mapped into memory as a whole.
+     *
+     * The pack starts with an identifier and the amount of entries, followed by the index of `AssetPackEntry`, the
+     * names, and the aligned assets. Assets are read in place from the mapping, so loading one only faults in its
+     * pages.
+     */
+    class AssetPack {
+        const std::byte *data = nullptr;
+        size_t size = 0;
+
+#ifdef _WIN32
+        void *fileHandle = nullptr;
+        void *mappingHandle = nullptr;
+#endif
+
+        std::unordered_map<std::string_view, std::span<const std::byte>> assets;
+
+    public:
+        /**
+         * Map the pack at `path` and read its index
+         */
+        explicit AssetPack(const std::string &path);
+
+        AssetPack(AssetPack &&assetPack) noexcept;
+
+        ~AssetPack();
+
+        AssetPack(const AssetPack &) = delete;
+
+        AssetPack &operator=(const AssetPack &) = delete;
+
+        /**
+         * @param name Path of the asset relative to the packed directory, separated by `/`
+         * @return Contents of the asset, valid as long as the pack is alive
+         */
+        [[nodiscard]] std::span<const std::byte> asset(std::string_view name) const;
+
+        /**
+         * @return Contents of a text asset, such as a shader
+         */
+        [[nodiscard]] std::string_view text(std::string_view name) const;
+
+        [[nodiscard]] bool contains(std::string_view name) const;
+
+    private:
+        void readIndex(const std::string &path);
+
+        void unmap();
+    };
+
+    /**
+     * A file to put in a pack
+     */
+    struct PackedFile {
+        std::string name;
+        std::string path;
+    };
+
+    /**
+     * Write the files into a pack at `path`
+     */
+    void writeAssetPack(const std::string &path, const std::vector<PackedFile> &files);
+}
+
+#endif //PROG2002_ASSETPACK_H
@@ -14,6 +14,21 @@ namespace framework {
         glm::vec3 target;
         glm::vec3 up;
 
+        /// Matrices computed from the fields above, recomputed only when those change
+        struct MatrixCache {
+            glm::mat4 projectionMatrix;
+            glm::vec3 position;
+            glm::vec3 target;
+            glm::vec3 up;
+
+            glm::mat4 viewMatrix;
+            glm::mat4 viewProjectionMatrix;
+
+            bool isValid = false;
+        };
+
+        mutable MatrixCache matrixCache = {};
+
         static Camera createOrthographic(
             float size,
             float aspectRatio,
@@ -35,6 +50,12 @@ namespace framework {
         );
 
         [[nodiscard]] glm::mat4 viewMatrix() const;
+
+        /// Projection matrix multiplied with view matrix
+        [[nodiscard]] glm::mat4 viewProjectionMatrix() const;
+
+    private:
+        void updateMatrixCache() const;
     };
 }
 
@@ -0,0 +1,60 @@
+#ifndef PROG2002_DIRTYRANGES_H
+#define PROG2002_DIRTYRANGES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace framework {
+    /**
+     * Element ranges of a buffer that changed since they were last uploaded
+     */
+    class DirtyRanges {
+    public:
+        /// Range of elements, from `begin` up to but not including `end`
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+    private:
+        std::vector<Range> ranges;
+
+    public:
+        /**
+         * Mark elements from `begin` up to but not including `end` as changed
+         */
+        void mark(uint32_t begin, uint32_t end);
+
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * Take every marked range out, sorted and with overlapping or adjacent ranges merged together
+         */
+        std::vector<Range> take();
+
+        /**
+         * Copy every element of `next` that differs from `current` into `current`, and mark it as changed. Elements
+         * past the end of the shorter of the two are left alone.
+         * @return `true` if any element changed
+         */
+        template<typename T>
+        bool markChanged(std::vector<T> &current, const std::vector<T> &next) {
+            bool changed = false;
+            auto elementsAmount = std::min(current.size(), next.size());
+
+            for (uint32_t index = 0; index < elementsAmount; ++index) {
+                if (std::memcmp(&current[index], &next[index], sizeof(T)) == 0) continue;
+
+                current[index] = next[index];
+                mark(index, index + 1);
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#endif //PROG2002_DIRTYRANGES_H
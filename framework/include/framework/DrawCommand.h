@@ -0,0 +1,92 @@
+#ifndef PROG2002_DRAWCOMMAND_H
+#define PROG2002_DRAWCOMMAND_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+#include "glad/glad.h"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "Shader.h"
+#include "Texture.h"
+#include "Sampler.h"
+#include "RenderState.h"
+
+namespace framework {
+    /**
+     * A single draw together with the state it needs, so it can be issued later or in a different order
+     */
+    struct DrawCommand {
+        /// Value of an uniform, captured when the command is created
+        using UniformValue = std::variant<bool, int, glm::ivec2, float, glm::vec3, glm::vec4, glm::mat4>;
+
+        struct Uniform {
+            UniformLocation location;
+            UniformValue value;
+        };
+
+        struct TextureBinding {
+            uint32_t unit;
+            uint32_t textureId;
+
+            /// Sampler object bound to the same unit, 0 samples with the parameters of the texture
+            uint32_t samplerId = 0;
+        };
+
+        struct BufferBinding {
+            uint32_t slot;
+            BufferRange range;
+        };
+
+        const Shader *shader;
+        uint32_t vertexArrayId;
+
+        GLenum drawMode = GL_TRIANGLES;
+
+        /// Amount of indices if `isIndexed`, otherwise amount of vertices
+        uint32_t elementsAmount;
+        bool isIndexed;
+        uint32_t instances = 1;
+
+        /// Polygon mode to draw with, leaves the current one if empty
+        std::optional<GLenum> polygonMode;
+
+        std::vector<TextureBinding> textures;
+        std::vector<BufferBinding> uniformBuffers;
+        std::vector<BufferBinding> shaderStorageBuffers;
+        std::vector<Uniform> uniforms;
+
+        /// Name of the `GpuProfiler` scope the command is timed as, not timed if empty
+        std::string label;
+
+        /// Upload uniform `name` of the shader right before drawing
+        DrawCommand &withUniform(const std::string &name, UniformValue value);
+
+        DrawCommand &withTexture(uint32_t unit, uint32_t textureId);
+
+        DrawCommand &withTexture(uint32_t unit, const Texture &texture);
+
+        /// Sample `texture` with `sampler` instead of its own parameters
+        DrawCommand &withTexture(uint32_t unit, const Texture &texture, const Sampler &sampler);
+
+        DrawCommand &withUniformBuffer(uint32_t slot, BufferRange range);
+
+        DrawCommand &withShaderStorageBuffer(uint32_t slot, BufferRange range);
+
+        DrawCommand &withPolygonMode(GLenum mode);
+
+        /// Time the command as the profiler scope `name`, draws with the same label are summed per frame
+        DrawCommand &withLabel(std::string name);
+
+        /// Texture bound to the lowest unit, 0 if there is none
+        [[nodiscard]] uint32_t primaryTextureId() const;
+
+        /**
+         * Apply the state of the command and draw
+         */
+        void issue() const;
+    };
+}
+
+#endif //PROG2002_DRAWCOMMAND_H
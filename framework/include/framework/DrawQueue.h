@@ -0,0 +1,60 @@
+#ifndef PROG2002_DRAWQUEUE_H
+#define PROG2002_DRAWQUEUE_H
+
+#include <cstdint>
+#include <vector>
+#include "glm/vec3.hpp"
+#include "DrawCommand.h"
+
+namespace framework {
+    /// Group of draws, passes are drawn in this order
+    enum class RenderPass : uint8_t {
+        /// Sorted by state, then front to back to reduce overdraw
+        Opaque,
+
+        /// Sorted back to front so blending is correct, then by state
+        Transparent
+    };
+
+    /**
+     * Collects draws during a frame and issues them sorted by a 64-bit key, so draws sharing a shader and texture
+     * end up next to each other and opaque geometry is drawn front to back
+     */
+    class DrawQueue {
+    private:
+        struct Entry {
+            uint64_t key;
+            uint32_t commandIndex;
+        };
+
+        std::vector<DrawCommand> commands;
+        std::vector<Entry> entries;
+
+        glm::vec3 cameraPosition = {0.f, 0.f, 0.f};
+
+    public:
+        /// Position depth is measured from, set before submitting the draws of a frame
+        void setCameraPosition(glm::vec3 position);
+
+        /**
+         * @param command Draw to issue on the next `flush`
+         * @param pass Pass the draw belongs to
+         * @param center World space center of the drawn object, used for depth sorting
+         */
+        void submit(DrawCommand command, RenderPass pass = RenderPass::Opaque, glm::vec3 center = {0.f, 0.f, 0.f});
+
+        /**
+         * Issue every submitted draw in sorted order, and empty the queue
+         */
+        void flush();
+
+        /**
+         * Key layout, most significant bits first:
+         * - Opaque: pass (2 bits), shader (16 bits), texture (16 bits), depth (24 bits)
+         * - Transparent: pass (2 bits), inverted depth (24 bits), shader (16 bits), texture (16 bits)
+         */
+        static uint64_t sortKey(RenderPass pass, uint32_t shaderId, uint32_t textureId, float depth);
+    };
+}
+
+#endif //PROG2002_DRAWQUEUE_H
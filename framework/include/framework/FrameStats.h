@@ -0,0 +1,100 @@
+#ifndef PROG2002_FRAMESTATS_H
+#define PROG2002_FRAMESTATS_H
+
+#include <cstdint>
+#include <ostream>
+#include <fstream>
+#include <filesystem>
+
+namespace framework {
+    /**
+     * Counters of work submitted to OpenGL during one frame
+     */
+    struct FrameStats {
+        /// Draw calls issued, a multi-draw counts as one
+        uint32_t drawCalls = 0;
+
+        /// Uniform values uploaded through `Shader`
+        uint32_t uniformUploads = 0;
+
+        /// Bytes written into buffer objects
+        uint64_t bufferBytesUploaded = 0;
+
+        /// Amount of separate buffer writes
+        uint32_t bufferUploads = 0;
+
+        /// Buffer objects created
+        uint32_t buffersCreated = 0;
+
+        /// Textures loaded or streamed in, and the size of their storage on the GPU
+        uint32_t texturesLoaded = 0;
+        uint64_t textureBytesLoaded = 0;
+
+        /// State changes passed on to OpenGL by `RenderState`
+        uint32_t stateChangesIssued = 0;
+
+        /// State changes skipped by `RenderState` because they would not change anything
+        uint32_t stateChangesSkipped = 0;
+    };
+
+    std::ostream &operator<<(std::ostream &output, const FrameStats &frameStats);
+
+    /**
+     * Logs the counters of every frame as a row of a CSV file, to compare runs before and after an optimization
+     */
+    class FrameStatsCsv {
+        std::ofstream file;
+        uint64_t frame = 0;
+
+    public:
+        /// Creates the file at `path` and writes the header row
+        explicit FrameStatsCsv(const std::filesystem::path &path);
+
+        void write(const FrameStats &frameStats);
+    };
+
+    /**
+     * Counters of the frame currently being recorded
+     */
+    FrameStats &frameStats();
+
+    /**
+     * Counters of the last finished frame
+     */
+    const FrameStats &previousFrameStats();
+
+    /**
+     * Finish the current frame, its counters move to `previousFrameStats()` and recording starts from zero
+     */
+    void endFrameStats();
+
+    /**
+     * Record a write of `bytes` into a buffer object
+     */
+    inline void countBufferUpload(uint64_t bytes) {
+        frameStats().bufferBytesUploaded += bytes;
+        frameStats().bufferUploads += 1;
+    }
+
+    inline void countDrawCall() {
+        frameStats().drawCalls += 1;
+    }
+
+    inline void countUniformUpload() {
+        frameStats().uniformUploads += 1;
+    }
+
+    inline void countBufferCreation() {
+        frameStats().buffersCreated += 1;
+    }
+
+    /**
+     * Record a texture with `bytes` of storage on the GPU being loaded
+     */
+    inline void countTextureLoad(uint64_t bytes) {
+        frameStats().textureBytesLoaded += bytes;
+        frameStats().texturesLoaded += 1;
+    }
+}
+
+#endif //PROG2002_FRAMESTATS_H
@@ -0,0 +1,64 @@
+#ifndef PROG2002_FRAMESTATSOVERLAY_H
+#define PROG2002_FRAMESTATSOVERLAY_H
+
+#include <cstdint>
+#include <string>
+#include "glm/vec2.hpp"
+#include "Shader.h"
+#include "FrameStats.h"
+
+namespace framework {
+    /**
+     * Draws frame counters as text in a corner of the screen, on top of everything drawn before it.
+     *
+     * Its own draw call, uploads and state changes are left out of the counters, so the numbers are the same whether
+     * the overlay is shown or not.
+     */
+    class FrameStatsOverlay {
+        /// Vertex layout written by `stb_easy_font_print`
+        struct Vertex {
+            float x;
+            float y;
+            float z;
+            uint8_t color[4];
+        };
+
+        Shader shader;
+        uint32_t vertexArrayId = 0;
+        uint32_t vertexBufferId = 0;
+        uint32_t indexBufferId = 0;
+
+        /// Amount of quads the index buffer has indices for
+        uint32_t quadsCapacity = 0;
+
+    public:
+        FrameStatsOverlay();
+
+        FrameStatsOverlay(FrameStatsOverlay &&overlay) noexcept;
+
+        ~FrameStatsOverlay();
+
+        FrameStatsOverlay(const FrameStatsOverlay &) = delete;
+
+        FrameStatsOverlay &operator=(const FrameStatsOverlay &) = delete;
+
+        /**
+         * Draw `frameStats` with its top left corner at `position` in pixels, on a framebuffer of `width` by `height`
+         * pixels, with every glyph pixel `scale` pixels wide
+         */
+        void draw(
+            const FrameStats &frameStats,
+            int width,
+            int height,
+            glm::vec2 position = {8.f, 8.f},
+            float scale = 2.f
+        );
+
+        /**
+         * @return Counters as one line per counter
+         */
+        static std::string text(const FrameStats &frameStats);
+    };
+}
+
+#endif //PROG2002_FRAMESTATSOVERLAY_H
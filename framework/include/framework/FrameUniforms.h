@@ -0,0 +1,53 @@
+#ifndef PROG2002_FRAMEUNIFORMS_H
+#define PROG2002_FRAMEUNIFORMS_H
+
+#include <string>
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/vec4.hpp"
+#include "Camera.h"
+#include "StreamingUniformBuffer.h"
+
+namespace framework {
+    /// Uniform buffer binding of the `FrameUniforms` block, reserved for it in every shader
+    const uint32_t FRAME_UNIFORMS_BINDING = 0;
+
+    /**
+     * Data shared by every draw in a frame, needs to comply with std140
+     */
+    struct FrameUniforms {
+        glm::mat4 view; // 64 bytes
+        glm::mat4 projection; // 64 bytes
+        glm::mat4 viewProjection; // 64 bytes
+
+        glm::vec3 cameraPosition; // 12 bytes
+        float time; // 4 bytes
+    };
+
+    /// GLSL declaration of the `FrameUniforms` block, fields are available as `frame.<name>`
+    // language=glsl
+    const std::string FRAME_UNIFORMS_GLSL = R"(
+        layout(std140, binding = 0) uniform FrameUniforms {
+            mat4 view;
+            mat4 projection;
+            mat4 view_projection;
+            vec3 camera_position;
+            float time;
+        } frame;
+    )";
+
+    /**
+     * Streams `FrameUniforms` to the GPU, update it once at the start of every frame
+     */
+    struct FrameUniformBuffer {
+        StreamingUniformBuffer<FrameUniforms> uniformBuffer;
+
+        static FrameUniformBuffer create();
+
+        /**
+         * Write the matrices of `camera` and `time`, and bind the block to `FRAME_UNIFORMS_BINDING`
+         */
+        void update(const Camera &camera, float time);
+    };
+}
+
+#endif //PROG2002_FRAMEUNIFORMS_H
@@ -0,0 +1,136 @@
+#ifndef PROG2002_GAMELOOP_H
+#define PROG2002_GAMELOOP_H
+
+#include <cstdint>
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+
+namespace framework {
+    /// How the start of each frame is timed
+    enum class FramePacing {
+        /// Wait for the display's vertical sync on swap
+        VSync,
+
+        /// Start the next frame as soon as the last one is done, to measure throughput
+        Uncapped,
+
+        /// Start frames at a fixed rate without vertical sync, sleeping and then spinning until each is due
+        Capped
+    };
+
+    struct GameLoopSettings {
+        /// Length of one simulation step, in seconds
+        double timeStep = 1. / 120.;
+
+        /// Most real time simulated in one frame, so a long stall does not cause ever more catch-up steps
+        double maxFrameTime = 0.25;
+
+        FramePacing pacing = FramePacing::VSync;
+
+        /// Frames per second with `FramePacing::Capped`
+        double frameRateCap = 60.;
+    };
+
+    /**
+     * Settings given with `--uncapped` or `--fps <frames per second>`, vertical sync otherwise. Exits with a usage
+     * error if the frame rate is not a positive number.
+     */
+    GameLoopSettings gameLoopSettings(int argc, char *argv[]);
+
+    /**
+     * Frame timing that runs the simulation in fixed steps independent of the frame rate:
+     *
+     * ```
+     * while (loop.beginFrame()) {
+     *     while (loop.step()) update(loop.timeStep());
+     *     render(loop.alpha());
+     *     framework::swapBuffers(window);
+     *     loop.endFrame();
+     * }
+     * ```
+     *
+     * Real time accumulates every frame and is used up in whole steps. The leftover `alpha` of a step is what
+     * rendering interpolates between the last two simulated states with, so motion stays smooth when the frame rate
+     * and the step rate differ.
+     */
+    class GameLoop {
+        GLFWwindow *window;
+        GameLoopSettings settings;
+
+        /// Real time at the start of the current frame
+        double frameStartTime;
+
+        /// Real time not simulated yet, less than a step after the steps of a frame
+        double accumulatedTime = 0.;
+
+        /// Time simulated by every step so far
+        double simulatedTime = 0.;
+
+        /// When the next frame is due with `FramePacing::Capped`
+        double nextFrameTime;
+
+        /// Longest a short sleep has taken recently, the pacing spins instead once less time than this remains
+        double sleepEstimate = 0.002;
+
+        uint64_t finishedFrames = 0;
+
+    public:
+        GameLoop(GLFWwindow *window, GameLoopSettings settings = {});
+
+        /**
+         * Poll events and take the real time passed since the last frame
+         *
+         * @return Whether to run the frame, false once the window should close
+         */
+        bool beginFrame();
+
+        /**
+         * Use up one step of the accumulated time, call until it returns false and update the simulation once per
+         * true
+         */
+        bool step();
+
+        /**
+         * @return Fraction of a step that real time is ahead of the last step, in [0, 1)
+         */
+        [[nodiscard]] float alpha() const;
+
+        /**
+         * @return Time simulated so far including `alpha`, for animations that do not need a fixed step
+         */
+        [[nodiscard]] double time() const;
+
+        [[nodiscard]] double timeStep() const;
+
+        /**
+         * @return Real time at the start of the current frame, from the same clock as `glfwGetTime`
+         */
+        [[nodiscard]] double frameStart() const;
+
+        /**
+         * Finish the frame after swapping buffers, waiting until the next frame is due when capped
+         */
+        void endFrame();
+
+        /**
+         * Switch pacing between frames, also changes the swap interval of the current context
+         */
+        void setPacing(FramePacing pacing, double frameRateCap = 60.);
+
+        [[nodiscard]] FramePacing pacing() const;
+
+        /**
+         * @return Frames finished so far
+         */
+        [[nodiscard]] uint64_t framesAmount() const;
+
+    private:
+        /**
+         * Sleep in short slices while there is time for another, then spin until `deadline`. Sleeping alone
+         * oversleeps by up to a scheduler tick, spinning alone burns a core for the whole wait.
+         */
+        void waitUntil(double deadline);
+    };
+}
+
+#endif //PROG2002_GAMELOOP_H
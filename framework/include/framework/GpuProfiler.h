@@ -0,0 +1,174 @@
+#ifndef PROG2002_GPUPROFILER_H
+#define PROG2002_GPUPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "glad/glad.h"
+#include "Trace.h"
+
+namespace framework {
+    /**
+     * Times named scopes of every frame on the CPU, and on the GPU with `GL_TIMESTAMP` queries.
+     *
+     * Queries of a frame are only read back `FRAMES_IN_FLIGHT` frames later, when the GPU has long finished them, so
+     * profiling never waits on the GPU. Each scope keeps its time per frame over the last `historyFrames` frames, a
+     * scope that runs several times in a frame is summed. Scopes can nest, the whole frame is the scope "Frame".
+     *
+     * While tracing, every GPU scope is also recorded on the trace timeline "GPU", shifted onto the CPU clock.
+     */
+    class GpuProfiler {
+    public:
+        /// Frames between issuing the queries of a frame and reading them back
+        static constexpr uint32_t FRAMES_IN_FLIGHT = 4;
+
+        /// Time spent in a scope per frame, in milliseconds
+        struct Timing {
+            double min = 0.;
+            double average = 0.;
+            double p99 = 0.;
+        };
+
+        struct ScopeStats {
+            std::string name;
+            Timing cpu;
+            Timing gpu;
+
+            /// Amount of frames the timings are over
+            uint32_t frames;
+        };
+
+        /**
+         * Times from construction until destruction as the scope `name`
+         */
+        class Scope {
+            GpuProfiler &profiler;
+
+        public:
+            Scope(GpuProfiler &profiler, const std::string &name);
+
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+        };
+
+    private:
+        /// A scope that ran during a frame, together with the queries that timed it
+        struct Sample {
+            uint32_t scopeIndex;
+            uint32_t beginQuery;
+            uint32_t endQuery;
+            double cpuMilliseconds;
+        };
+
+        /// A scope that has begun but not ended yet
+        struct OpenScope {
+            uint32_t scopeIndex;
+            uint32_t beginQuery;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        /// Queries of one frame of the ring, reused every `FRAMES_IN_FLIGHT` frames
+        struct FrameQueries {
+            std::vector<uint32_t> queryIds;
+            uint32_t queriesUsed = 0;
+            std::vector<Sample> samples;
+
+            /// Whether the queries were issued but not read back yet
+            bool isPending = false;
+        };
+
+        /// Last `historyFrames` per-frame times of a scope, oldest overwritten first
+        struct History {
+            std::string name;
+            const char *traceName;
+            std::vector<double> cpu;
+            std::vector<double> gpu;
+            uint32_t next = 0;
+        };
+
+        bool enabled = false;
+        bool isInFrame = false;
+        uint32_t historyFrames;
+
+        std::array<FrameQueries, FRAMES_IN_FLIGHT> frames;
+        uint32_t frameIndex = 0;
+        std::vector<OpenScope> openScopes;
+
+        std::unordered_map<std::string, uint32_t> scopeIndices;
+        std::vector<History> histories;
+
+        /// Frames whose queries were still not finished when read back, and were skipped instead of waited on
+        uint32_t skippedFrames = 0;
+
+        /// Trace timeline of GPU scopes, and the difference from GPU timestamps to `traceTime`
+        TraceBuffer *gpuTrack = nullptr;
+        int64_t gpuClockOffset = 0;
+
+    public:
+        explicit GpuProfiler(uint32_t historyFrames = 300);
+
+        ~GpuProfiler();
+
+        GpuProfiler(const GpuProfiler &) = delete;
+
+        GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+        /**
+         * Start profiling, scopes are ignored until then so annotations cost nothing when not profiling
+         */
+        void enable();
+
+        [[nodiscard]] bool isEnabled() const;
+
+        /**
+         * Start the scopes of a new frame, reading back the results of the frame `FRAMES_IN_FLIGHT` frames ago
+         */
+        void beginFrame();
+
+        /**
+         * End the scopes of the current frame, every scope begun during the frame must have ended
+         */
+        void endFrame();
+
+        void beginScope(const std::string &name);
+
+        void endScope();
+
+        /**
+         * @return Timings of every scope seen so far, in the order they first ran
+         */
+        [[nodiscard]] std::vector<ScopeStats> stats() const;
+
+        [[nodiscard]] uint32_t skippedFramesAmount() const;
+
+        /**
+         * Write the timings as CSV with a header row, one row per scope
+         */
+        void writeCsv(std::ostream &output) const;
+
+        /**
+         * Delete every query, has to be called before the context is destroyed
+         */
+        void clear();
+
+    private:
+        uint32_t scopeIndex(const std::string &name);
+
+        uint32_t issueTimestamp();
+
+        void readBack(FrameQueries &frame);
+    };
+
+    std::ostream &operator<<(std::ostream &output, const GpuProfiler &profiler);
+
+    GpuProfiler &gpuProfiler();
+}
+
+#endif //PROG2002_GPUPROFILER_H
@@ -0,0 +1,75 @@
+#ifndef PROG2002_IMAGEPROCESSING_H
+#define PROG2002_IMAGEPROCESSING_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace framework {
+    /// Instruction sets the image kernels can use, each includes the ones before it
+    enum class SimdLevel {
+        Scalar,
+        Sse2,
+        Ssse3,
+        Avx2
+    };
+
+    /**
+     * @return Highest instruction set supported by the CPU and the operating system, checked once
+     */
+    SimdLevel simdLevel();
+
+    const char *simdLevelName(SimdLevel level);
+
+    /// Encoding of the colors of an image
+    enum class ColorSpace {
+        /// Stored and sampled as is, for data such as normal maps
+        Linear,
+
+        /// sRGB encoded colors, stored as `GL_SRGB8_ALPHA8` so that sampling returns linear values
+        Srgb
+    };
+
+    /**
+     * CPU work done on decoded pixels before they are uploaded
+     */
+    struct ImageProcessing {
+        /// Encoding of the colors in the file
+        ColorSpace colorSpace = ColorSpace::Linear;
+
+        /// Convert sRGB colors to linear on the CPU and store them as such, loses precision in dark colors
+        bool convertToLinear = false;
+
+        /// Multiply colors by alpha, in the encoding they are stored in
+        bool premultiplyAlpha = false;
+
+        /// Put the first row at the bottom, as OpenGL expects it
+        bool flipVertically = false;
+    };
+
+    /*
+     * Kernels over tightly packed 8-bit pixels. Every kernel uses the best implementation up to `level`, which all
+     * give the same result as the scalar one.
+     */
+
+    /**
+     * Copy RGB pixels into RGBA pixels with an opaque alpha
+     */
+    void expandRgbToRgba(const uint8_t *rgb, uint8_t *rgba, size_t pixelsAmount, SimdLevel level = simdLevel());
+
+    /**
+     * Multiply the color of RGBA pixels by their alpha in place, rounded to nearest
+     */
+    void premultiplyAlpha(uint8_t *rgba, size_t pixelsAmount, SimdLevel level = simdLevel());
+
+    /**
+     * Decode the sRGB colors of RGBA pixels to linear in place, alpha is kept as is
+     */
+    void srgbToLinear(uint8_t *rgba, size_t pixelsAmount, SimdLevel level = simdLevel());
+
+    /**
+     * Reverse the order of the rows of an image in place
+     */
+    void flipVertically(uint8_t *pixels, size_t rowBytes, size_t rows, SimdLevel level = simdLevel());
+}
+
+#endif //PROG2002_IMAGEPROCESSING_H
@@ -0,0 +1,101 @@
+#ifndef PROG2002_MATERIALTABLE_H
+#define PROG2002_MATERIALTABLE_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <optional>
+#include "Texture.h"
+#include "ShaderSource.h"
+#include "ShaderStorageBuffer.h"
+
+namespace framework {
+    /**
+     * GLSL for shaders that read a `MaterialTable`, include as `framework/materials.glsl` and compile with the
+     * defines of `MaterialTable::shaderDefines`. `sampleMaterial(material, uv)` samples the texture of a material.
+     */
+    // language=glsl
+    const std::string MATERIALS_GLSL = R"(
+        #ifdef BINDLESS_MATERIALS
+        #extension GL_ARB_bindless_texture : require
+
+        layout(std430, binding = MATERIALS_BINDING) readonly buffer Materials {
+            uvec2 material_handles[];
+        };
+
+        vec4 sampleMaterial(uint material, vec2 uv) {
+            return texture(sampler2D(material_handles[material]), uv);
+        }
+        #else
+        layout(binding = MATERIALS_BINDING) uniform sampler2DArray material_textures;
+
+        vec4 sampleMaterial(uint material, vec2 uv) {
+            return texture(material_textures, vec3(uv, float(material)));
+        }
+        #endif
+    )";
+
+    /**
+     * @return Whether the driver supports `GL_ARB_bindless_texture`, checked once
+     */
+    bool hasBindlessTextures();
+
+    /**
+     * Textures of many materials, so that one draw can use a different texture per draw or instance by material
+     * index instead of rebinding texture units between draws.
+     *
+     * With `GL_ARB_bindless_texture` every material is its own texture, made resident and read by handle from a
+     * shader storage buffer. Otherwise every material is a layer of one texture array, and needs the same size.
+     */
+    class MaterialTable {
+        uint32_t binding;
+
+        /// Textures with resident handles, only for bindless materials
+        std::vector<Texture> textures;
+        std::vector<uint64_t> handles;
+        std::optional<ShaderStorageBuffer<uint64_t>> handleBuffer;
+
+        /// Every material as a layer, only without bindless materials
+        std::optional<Texture> textureArray;
+
+    public:
+        /**
+         * Upload one material per image, the material index being the index of the image
+         * @param binding Shader storage buffer binding or texture unit the table is bound to
+         * @param allowBindless Whether to use bindless textures when the driver supports them
+         */
+        explicit MaterialTable(
+            std::span<const Image> images,
+            uint32_t binding = 1,
+            bool allowBindless = true,
+            Filtering filtering = Filtering::LinearMipmap,
+            Wrapping wrapping = Wrapping::Repeat,
+            Mipmaps mipmaps = Mipmaps::Gpu
+        );
+
+        MaterialTable(MaterialTable &&materialTable) noexcept;
+
+        ~MaterialTable();
+
+        MaterialTable(const MaterialTable &) = delete;
+
+        MaterialTable &operator=(const MaterialTable &) = delete;
+
+        [[nodiscard]] bool isBindless() const;
+
+        /**
+         * @return Defines that `framework/materials.glsl` needs to read this table
+         */
+        [[nodiscard]] ShaderDefines shaderDefines() const;
+
+        /**
+         * Bind to the binding given at creation, before drawing with shaders that read the table
+         */
+        void bind() const;
+
+        [[nodiscard]] TextureMemory memory() const;
+    };
+}
+
+#endif //PROG2002_MATERIALTABLE_H
@@ -0,0 +1,42 @@
+#ifndef PROG2002_MIPMAPS_H
+#define PROG2002_MIPMAPS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace framework {
+    /// Where and how the mip levels of a texture are made
+    enum class Mipmaps {
+        /// `glGenerateTextureMipmap` after uploading level 0, filter chosen by the driver
+        Gpu,
+
+        /// Averages of 2x2 pixels, computed on the CPU
+        CpuBox,
+
+        /// Kaiser windowed sinc, sharper than a box filter, computed on the CPU
+        CpuKaiser
+    };
+
+    /**
+     * RGBA8 pixels of one mip level
+     */
+    struct MipLevel {
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;
+    };
+
+    /**
+     * @return Amount of levels in a full mip chain, `floor(log2(max(width, height))) + 1`
+     */
+    uint32_t mipLevelsAmount(int width, int height);
+
+    /**
+     * Filter every level below level 0 of a RGBA8 image, each level is split over all hardware threads
+     * @param filter `Mipmaps::CpuBox` or `Mipmaps::CpuKaiser`
+     * @return Levels 1 and up
+     */
+    std::vector<MipLevel> generateMipmaps(const uint8_t *pixels, int width, int height, Mipmaps filter);
+}
+
+#endif //PROG2002_MIPMAPS_H
@@ -0,0 +1,211 @@
+#ifndef PROG2002_MULTIDRAWBATCH_H
+#define PROG2002_MULTIDRAWBATCH_H
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <optional>
+#include <cassert>
+#include "glad/glad.h"
+#include "VertexArray.h"
+#include "FrameStats.h"
+#include "ShaderStorageBuffer.h"
+
+namespace framework {
+    /**
+     * GLSL needed by shaders drawn through a `MultiDrawBatch`, paste right after `#version`.
+     * `DRAW_ID` is the index of the current draw, use it to read the per-draw data.
+     */
+    // language=glsl
+    const std::string MULTI_DRAW_GLSL = R"(
+        #extension GL_ARB_shader_draw_parameters : require
+        #define DRAW_ID gl_DrawIDARB
+    )";
+
+    /**
+     * Many meshes packed into shared vertex and index buffers, drawn with a single `glMultiDrawElementsIndirect`.
+     *
+     * Every draw has an element of `DrawDataType` that shaders read from a shader storage buffer at
+     * `drawDataBinding`, indexed with `DRAW_ID`. `DrawDataType` needs to comply with std430.
+     */
+    template<typename VertexType, typename DrawDataType>
+    class MultiDrawBatch {
+    public:
+        /// Location of a mesh inside the shared buffers
+        struct Mesh {
+            uint32_t firstIndex;
+            uint32_t indicesAmount;
+            int32_t baseVertex;
+        };
+
+    private:
+        /// Layout read by OpenGL from the indirect buffer
+        struct DrawElementsIndirectCommand {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
+        std::shared_ptr<Shader> shader;
+        std::vector<VertexAttribute> attributes;
+        uint32_t drawDataBinding;
+
+        /// Meshes added since the last `build`
+        std::vector<VertexType> vertices;
+        std::vector<IndexBuffer::IndexType> indices;
+
+        std::optional<VertexArray<VertexType>> vertexArray;
+
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<DrawDataType> drawData;
+
+        uint32_t indirectBufferId = 0;
+        ShaderStorageBuffer<DrawDataType> drawDataBuffer = ShaderStorageBuffer<DrawDataType>::create({});
+
+        /// Amount of commands the GPU buffers currently have room for
+        uint32_t capacity = 0;
+
+        /// Whether draws changed since they were last uploaded
+        bool hasChangedDraws = false;
+
+    public:
+        MultiDrawBatch(
+            std::shared_ptr<Shader> shader,
+            std::vector<VertexAttribute> attributes,
+            uint32_t drawDataBinding = 0
+        ) : shader(std::move(shader)), attributes(std::move(attributes)), drawDataBinding(drawDataBinding) {
+            glCreateBuffers(1, &indirectBufferId);
+            countBufferCreation();
+        }
+
+        MultiDrawBatch(MultiDrawBatch &&object) noexcept:
+            shader(std::move(object.shader)),
+            attributes(std::move(object.attributes)),
+            drawDataBinding(object.drawDataBinding),
+            vertices(std::move(object.vertices)),
+            indices(std::move(object.indices)),
+            vertexArray(std::move(object.vertexArray)),
+            commands(std::move(object.commands)),
+            drawData(std::move(object.drawData)),
+            indirectBufferId(object.indirectBufferId),
+            drawDataBuffer(std::move(object.drawDataBuffer)),
+            capacity(object.capacity),
+            hasChangedDraws(object.hasChangedDraws) {
+            object.indirectBufferId = 0;
+        }
+
+        ~MultiDrawBatch() {
+            if (indirectBufferId) glDeleteBuffers(1, &indirectBufferId);
+        }
+
+        MultiDrawBatch(const MultiDrawBatch &) = delete;
+
+        MultiDrawBatch &operator=(const MultiDrawBatch &) = delete;
+
+        /**
+         * Add a mesh to the shared buffers, every mesh has to be added before `build`
+         */
+        Mesh addMesh(const std::vector<VertexType> &meshVertices, const std::vector<IndexBuffer::IndexType> &meshIndices) {
+            assert(!vertexArray.has_value());
+
+            Mesh mesh = {
+                .firstIndex = (uint32_t) indices.size(),
+                .indicesAmount = (uint32_t) meshIndices.size(),
+                .baseVertex = (int32_t) vertices.size()
+            };
+
+            vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+            indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+
+            return mesh;
+        }
+
+        /**
+         * Upload every added mesh into the shared vertex and index buffers
+         */
+        void build() {
+            vertexArray.emplace(
+                shader,
+                attributes,
+                VertexBuffer<VertexType>(std::move(vertices)),
+                IndexBuffer(std::move(indices))
+            );
+
+            vertices = {};
+            indices = {};
+        }
+
+        /**
+         * Remove every draw, to add the draws of a new frame
+         */
+        void clearDraws() {
+            commands.clear();
+            drawData.clear();
+            hasChangedDraws = true;
+        }
+
+        /**
+         * Draw `mesh` `instances` times with `data` as its per-draw data
+         */
+        void addDraw(Mesh mesh, const DrawDataType &data, uint32_t instances = 1) {
+            commands.push_back(
+                {
+                    .count = mesh.indicesAmount,
+                    .instanceCount = instances,
+                    .firstIndex = mesh.firstIndex,
+                    .baseVertex = mesh.baseVertex,
+                    .baseInstance = 0
+                }
+            );
+            drawData.push_back(data);
+            hasChangedDraws = true;
+        }
+
+        [[nodiscard]] uint32_t drawsAmount() const {
+            return commands.size();
+        }
+
+        /**
+         * Issue every added draw with one call
+         */
+        void draw(GLenum drawMode = GL_TRIANGLES) {
+            assert(vertexArray.has_value());
+            if (commands.empty()) return;
+
+            if (hasChangedDraws) uploadDraws();
+
+            renderState().useProgram(shader->id);
+            renderState().bindVertexArray(vertexArray->vertexArrayId);
+
+            drawDataBuffer.bind(drawDataBinding);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBufferId);
+
+            glMultiDrawElementsIndirect(drawMode, GL_UNSIGNED_INT, nullptr, (int32_t) commands.size(), 0);
+            countDrawCall();
+        }
+
+    private:
+        void uploadDraws() {
+            auto commandsSize = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+            if (commands.size() > capacity) {
+                // Grow to fit, reallocating the store
+                capacity = commands.size();
+                glNamedBufferData(indirectBufferId, (GLsizeiptr) commandsSize, commands.data(), GL_DYNAMIC_DRAW);
+            } else {
+                glNamedBufferSubData(indirectBufferId, 0, (GLsizeiptr) commandsSize, commands.data());
+            }
+            countBufferUpload(commandsSize);
+
+            // Only uploads the draw data that changed since last time
+            drawDataBuffer.updateData(drawData);
+
+            hasChangedDraws = false;
+        }
+    };
+}
+
+#endif //PROG2002_MULTIDRAWBATCH_H
@@ -0,0 +1,96 @@
+#ifndef PROG2002_PENDINGSHADER_H
+#define PROG2002_PENDINGSHADER_H
+
+#include <string>
+#include <memory>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+#include "Shader.h"
+
+namespace framework {
+    /**
+     * Time from starting a program until each step was seen to be finished
+     */
+    struct ShaderTiming {
+        double compileMilliseconds;
+        double linkMilliseconds;
+
+        /// Whether the program was loaded from the shader cache instead of compiled
+        bool wasCached;
+    };
+
+    std::ostream &operator<<(std::ostream &output, const ShaderTiming &timing);
+
+    /**
+     * A shader program that is being compiled and linked in the background.
+     *
+     * With `GL_KHR_parallel_shader_compile` the driver compiles on its own threads and `isReady` never blocks, so
+     * starting every program before waiting on any of them overlaps their compilation. Without the extension each
+     * step runs synchronously the first time it is polled.
+     */
+    class PendingShader {
+        enum class Step {
+            Compiling,
+            Linking,
+            Done
+        };
+
+        std::string vertexShaderSource;
+        std::string fragmentShaderSource;
+
+        uint32_t vertexShader = 0;
+        uint32_t fragmentShader = 0;
+        uint32_t program = 0;
+
+        Step step = Step::Compiling;
+
+        std::chrono::steady_clock::time_point stepStartTime;
+        ShaderTiming shaderTiming = {};
+
+    public:
+        /**
+         * Start compiling both stages, or load the program from the shader cache
+         */
+        PendingShader(std::string vertexShaderSource, std::string fragmentShaderSource);
+
+        PendingShader(PendingShader &&pendingShader) noexcept;
+
+        ~PendingShader();
+
+        PendingShader(const PendingShader &) = delete;
+
+        PendingShader &operator=(const PendingShader &) = delete;
+
+        /**
+         * Advance as far as possible without waiting on the driver
+         * @return Whether the program is linked
+         */
+        bool isReady();
+
+        /**
+         * Wait until the program is linked and take ownership of it
+         * @return Id of the linked program, the caller is responsible for deleting it
+         */
+        uint32_t waitForProgram();
+
+        /**
+         * Wait until the program is linked
+         */
+        std::shared_ptr<Shader> get();
+
+        /**
+         * Timing of the steps finished so far, complete once ready
+         */
+        [[nodiscard]] const ShaderTiming &timing() const;
+
+    private:
+        /**
+         * Check the results of the finished step and start the next one
+         * @param wait Whether to block until the driver is finished with the current step
+         */
+        void advance(bool wait);
+    };
+}
+
+#endif //PROG2002_PENDINGSHADER_H
@@ -0,0 +1,104 @@
+#ifndef PROG2002_PIXELUPLOADRING_H
+#define PROG2002_PIXELUPLOADRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
+#include "glad/glad.h"
+
+namespace framework {
+    /**
+     * A persistently mapped pixel unpack buffer that decoded images are copied into from any thread, so the thread
+     * uploading them only queues copies on the GPU.
+     *
+     * Regions are handed out in ring order. A region is reused once the fence placed after the uploads that read it
+     * has signaled, so writing the next images overlaps the GPU copying the previous ones out of the buffer.
+     */
+    class PixelUploadRing {
+    public:
+        /// Alignment of the start of every region
+        static const size_t ALIGNMENT = 64;
+
+        struct Region {
+            /// Offset from the start of the buffer, to upload from while the buffer is bound
+            size_t offset;
+
+            size_t size;
+
+            /// Mapped memory of the region, to copy pixels into
+            std::byte *data;
+        };
+
+    private:
+        struct Allocation {
+            size_t offset;
+            size_t size;
+
+            /// Placed after the uploads that read the region, `nullptr` until it is retired
+            GLsync fence = nullptr;
+
+            bool isRetired = false;
+        };
+
+        uint32_t pixelBufferId = 0;
+        size_t capacity;
+
+        /// Persistently mapped memory of the whole buffer
+        std::byte *mapping = nullptr;
+
+        std::mutex mutex;
+
+        /// Notified when regions are reclaimed or the ring is stopped
+        std::condition_variable spaceCondition;
+
+        /// Regions in use, in the order they were reserved
+        std::deque<Allocation> allocations;
+
+        bool isStopping = false;
+
+    public:
+        /**
+         * Create and map the buffer on the current context
+         */
+        explicit PixelUploadRing(size_t capacity);
+
+        /**
+         * Delete the buffer, has to run with a context current that shares the buffer
+         */
+        ~PixelUploadRing();
+
+        PixelUploadRing(const PixelUploadRing &) = delete;
+
+        PixelUploadRing &operator=(const PixelUploadRing &) = delete;
+
+        /**
+         * Reserve a region of `size` bytes, waiting until enough of the ring has been reclaimed. Can be called from
+         * any thread.
+         * @return The region, or nothing if `size` is larger than the ring or the ring is stopping
+         */
+        std::optional<Region> reserve(size_t size);
+
+        /**
+         * Place a fence after the uploads that read `region`, call from the thread that issued them
+         */
+        void retire(const Region &region);
+
+        /**
+         * Free every region at the start of the ring whose uploads are done, call from a thread with a context current
+         * @return Whether any region is still in use
+         */
+        bool reclaim();
+
+        /**
+         * Make every waiting and later `reserve` return nothing
+         */
+        void stop();
+
+        [[nodiscard]] uint32_t bufferId() const;
+    };
+}
+
+#endif //PROG2002_PIXELUPLOADRING_H
@@ -0,0 +1,110 @@
+#ifndef PROG2002_RENDERSTATE_H
+#define PROG2002_RENDERSTATE_H
+
+#include <array>
+#include <cstdint>
+#include "glad/glad.h"
+
+namespace framework {
+    /**
+     * Range of a buffer that can be bound to an indexed binding
+     */
+    struct BufferRange {
+        uint32_t bufferId;
+
+        /// Offset in bytes from the start of the buffer
+        GLintptr offset = 0;
+
+        /// Size in bytes, 0 means the whole buffer
+        GLsizeiptr size = 0;
+
+        bool operator==(const BufferRange &) const = default;
+    };
+
+    /**
+     * Shadow copy of the OpenGL state that the framework changes, used to skip calls that would not change anything.
+     *
+     * Only correct as long as the state is changed through it, call `invalidate()` after changing any of it directly.
+     */
+    class RenderState {
+    public:
+        /// Amount of texture units that are tracked
+        static const uint32_t TEXTURE_UNITS = 32;
+
+        /// Amount of uniform buffer bindings that are tracked
+        static const uint32_t UNIFORM_BUFFER_BINDINGS = 16;
+
+        /// Amount of shader storage buffer bindings that are tracked
+        static const uint32_t SHADER_STORAGE_BUFFER_BINDINGS = 16;
+
+    private:
+        /// Placeholder for state that is not known, forces the next call to be issued
+        static const uint32_t UNKNOWN = UINT32_MAX;
+
+        uint32_t program;
+        uint32_t vertexArray;
+        std::array<uint32_t, TEXTURE_UNITS> textures;
+        std::array<uint32_t, TEXTURE_UNITS> samplers;
+        std::array<BufferRange, UNIFORM_BUFFER_BINDINGS> uniformBuffers;
+        std::array<BufferRange, SHADER_STORAGE_BUFFER_BINDINGS> shaderStorageBuffers;
+        GLenum polygonMode;
+        int depthTest;
+        int depthWrite;
+        GLenum depthFunction;
+
+        /// Record whether a call was issued or skipped, returns `shouldIssue`
+        static bool count(bool shouldIssue);
+
+    public:
+        RenderState();
+
+        void useProgram(uint32_t programId);
+
+        void bindVertexArray(uint32_t vertexArrayId);
+
+        void bindTextureUnit(uint32_t unit, uint32_t textureId);
+
+        /// Bind a sampler object to texture unit `unit`, 0 samples with the parameters of the texture
+        void bindSampler(uint32_t unit, uint32_t samplerId);
+
+        /// Bind a range of a buffer to uniform buffer binding `slot`
+        void bindUniformBuffer(uint32_t slot, BufferRange range);
+
+        /// Bind a range of a buffer to shader storage buffer binding `slot`
+        void bindShaderStorageBuffer(uint32_t slot, BufferRange range);
+
+        /// Polygon mode used for both front and back faces
+        void setPolygonMode(GLenum mode);
+
+        void setDepthTest(bool enabled);
+
+        void setDepthWrite(bool enabled);
+
+        void setDepthFunction(GLenum function);
+
+        /// Forget all state, every next call will be issued
+        void invalidate();
+
+        /// Forget a program that is about to be deleted
+        void forgetProgram(uint32_t programId);
+
+        /// Forget a vertex array that is about to be deleted
+        void forgetVertexArray(uint32_t vertexArrayId);
+
+        /// Forget a texture that is about to be deleted
+        void forgetTexture(uint32_t textureId);
+
+        /// Forget a sampler that is about to be deleted
+        void forgetSampler(uint32_t samplerId);
+
+        /// Forget a buffer that is about to be deleted
+        void forgetBuffer(uint32_t bufferId);
+    };
+
+    /**
+     * Render state of the current OpenGL context
+     */
+    RenderState &renderState();
+}
+
+#endif //PROG2002_RENDERSTATE_H
@@ -0,0 +1,92 @@
+#ifndef PROG2002_SAMPLER_H
+#define PROG2002_SAMPLER_H
+
+#include <cstdint>
+#include <map>
+#include "glad/glad.h"
+#include "Texture.h"
+
+namespace framework {
+    /**
+     * How a texture is sampled, independent of the texture
+     */
+    struct SamplerState {
+        Filtering filtering = Filtering::LinearMipmap;
+        Wrapping wrapping = Wrapping::Repeat;
+
+        /// Maximum anisotropy, 1 disables anisotropic filtering. Clamped to what the driver supports
+        float anisotropy = 1.f;
+
+        auto operator<=>(const SamplerState &) const = default;
+    };
+
+    /**
+     * @return OpenGL wrap mode of `wrapping`
+     */
+    GLenum glWrapMode(Wrapping wrapping);
+
+    /**
+     * @return OpenGL minification filter of `filtering`
+     */
+    GLenum glMinFilter(Filtering filtering);
+
+    /**
+     * @return OpenGL magnification filter of `filtering`
+     */
+    GLenum glMagFilter(Filtering filtering);
+
+    /**
+     * @return Highest anisotropy the driver supports, 1 without anisotropic filtering. Checked once
+     */
+    float maxAnisotropy();
+
+    /**
+     * An OpenGL sampler object. While bound to a texture unit, it replaces the sampling parameters of whatever
+     * texture is bound to that unit, so one texture can be sampled in several ways.
+     */
+    class Sampler {
+        uint32_t id;
+
+    public:
+        explicit Sampler(SamplerState state);
+
+        Sampler(Sampler &&sampler) noexcept;
+
+        ~Sampler();
+
+        Sampler(const Sampler &) = delete;
+
+        Sampler &operator=(const Sampler &) = delete;
+
+        [[nodiscard]] uint32_t samplerId() const;
+
+        void bind(uint32_t unit) const;
+    };
+
+    /**
+     * Shares one sampler object between every user of the same `SamplerState`
+     */
+    class SamplerCache {
+        std::map<SamplerState, Sampler> samplers;
+
+    public:
+        /**
+         * @return Sampler with `state`, created on first use. Stays valid as long as the cache
+         */
+        const Sampler &sampler(SamplerState state);
+
+        /**
+         * @return Amount of distinct sampler objects created
+         */
+        [[nodiscard]] size_t samplersAmount() const;
+
+        /**
+         * Delete every sampler, has to be called before the context is destroyed
+         */
+        void clear();
+    };
+
+    SamplerCache &samplerCache();
+}
+
+#endif //PROG2002_SAMPLER_H
@@ -2,16 +2,41 @@
 #define PROG2002_SHADER_H
 
 #include <string>
+#include <unordered_map>
 #include "glm/ext/matrix_float4x4.hpp"
 #include "UniformBuffer.h"
 
 namespace framework {
+    /**
+     * Location of a uniform, obtained once with `Shader::uniformLocation` and reused for every upload
+     */
+    struct UniformLocation {
+        int32_t location = -1;
+    };
+
     class Shader {
     public:
         uint32_t id;
 
+    private:
+        /// Location of every active uniform, reflected once after linking
+        std::unordered_map<std::string, int32_t> uniformLocations;
+
+        /// Index of every active uniform block, reflected once after linking
+        std::unordered_map<std::string, uint32_t> uniformBlockIndices;
+
+    public:
+
+        /**
+         * Compile and link the program, blocking until it is done. Use `PendingShader` to compile in the background
+         */
         Shader(const std::string &vertexShaderSource, const std::string &fragmentShaderSource);
 
+        /**
+         * Take ownership of an already linked program
+         */
+        explicit Shader(uint32_t programId);
+
         Shader(Shader &&shader) noexcept;
 
         ~Shader();
@@ -20,6 +45,30 @@ namespace framework {
 
         Shader &operator=(const Shader &) = delete;
 
+        /**
+         * Look up the location of an active uniform, without asking the driver
+         */
+        [[nodiscard]] UniformLocation uniformLocation(const std::string &name) const;
+
+        /**
+         * Look up the index of an active uniform block, without asking the driver
+         */
+        [[nodiscard]] uint32_t uniformBlockIndex(const std::string &name) const;
+
+        void uploadUniformBool1(UniformLocation location, bool value) const;
+
+        void uploadUniformInt1(UniformLocation location, int value) const;
+
+        void uploadUniformInt2(UniformLocation location, glm::ivec2 value) const;
+
+        void uploadUniformFloat1(UniformLocation location, float value) const;
+
+        void uploadUniformFloat3(UniformLocation location, glm::vec3 value) const;
+
+        void uploadUniformFloat4(UniformLocation location, glm::vec4 value) const;
+
+        void uploadUniformMatrix4(UniformLocation location, glm::mat4 value) const;
+
         void uploadUniformBool1(const std::string &name, bool value) const;
 
         void uploadUniformInt1(const std::string &name, int value) const;
@@ -34,13 +83,19 @@ namespace framework {
 
         void uploadUniformMatrix4(const std::string &name, glm::mat4 value) const;
 
-        template<typename T>
-        void uploadUniformBuffer(const std::string &name, uint32_t slot, const UniformBuffer<T> &uniformBuffer) const {
-            glBindBufferBase(GL_UNIFORM_BUFFER, slot, uniformBuffer.uniformBufferId);
-            uint32_t uniformBufferIndex = glGetUniformBlockIndex(id, name.c_str());
-            assert(uniformBufferIndex != GL_INVALID_INDEX);
-
-            glUniformBlockBinding(id, uniformBufferIndex, slot);
+        /**
+         * Point uniform block `name` at uniform buffer binding `slot`
+         */
+        void bindUniformBlock(const std::string &name, uint32_t slot) const;
+
+        /**
+         * Bind `uniformBuffer` to `slot` and use it for uniform block `name`
+         * @param uniformBuffer Either an `UniformBuffer` or a `StreamingUniformBuffer`
+         */
+        template<typename UniformBufferType>
+        void uploadUniformBuffer(const std::string &name, uint32_t slot, const UniformBufferType &uniformBuffer) const {
+            uniformBuffer.bind(slot);
+            bindUniformBlock(name, slot);
         }
     };
 }
@@ -0,0 +1,68 @@
+#ifndef PROG2002_SHADERCACHE_H
+#define PROG2002_SHADERCACHE_H
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include <ostream>
+#include <cstdint>
+
+namespace framework {
+    /**
+     * Time spent creating shader programs, and how many of them came from the cache
+     */
+    struct ShaderCacheStats {
+        uint32_t programsLoaded;
+        uint32_t programsCompiled;
+        double milliseconds;
+    };
+
+    std::ostream &operator<<(std::ostream &output, const ShaderCacheStats &stats);
+
+    /**
+     * Stores linked programs on disk with `glGetProgramBinary`, so later runs can skip compiling and linking.
+     *
+     * Programs are keyed by a hash of their final sources and the driver, a binary the driver refuses is compiled
+     * again and replaced.
+     */
+    class ShaderCache {
+        /// Empty while the cache is disabled
+        std::optional<std::filesystem::path> directory;
+
+        ShaderCacheStats stats = {};
+
+    public:
+        /**
+         * Store and look up programs in `cacheDirectory`, created if missing
+         */
+        void enable(const std::filesystem::path &cacheDirectory);
+
+        [[nodiscard]] bool isEnabled() const;
+
+        /**
+         * @param sources Final source of every stage of the program
+         * @return Program linked from the cached binary, empty if there is none or the driver refused it
+         */
+        std::optional<uint32_t> load(const std::vector<std::string> &sources);
+
+        /**
+         * Save the binary of `program`, which needs to be linked with `GL_PROGRAM_BINARY_RETRIEVABLE_HINT` set
+         */
+        void store(const std::vector<std::string> &sources, uint32_t program) const;
+
+        /**
+         * Add the creation of a program to the stats
+         */
+        void countProgram(bool wasLoaded, double milliseconds);
+
+        [[nodiscard]] const ShaderCacheStats &cacheStats() const;
+
+    private:
+        [[nodiscard]] std::filesystem::path binaryPath(const std::vector<std::string> &sources) const;
+    };
+
+    ShaderCache &shaderCache();
+}
+
+#endif //PROG2002_SHADERCACHE_H
@@ -0,0 +1,86 @@
+#ifndef PROG2002_SHADERSOURCE_H
+#define PROG2002_SHADERSOURCE_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include "Shader.h"
+#include "PendingShader.h"
+
+namespace framework {
+    /**
+     * Value of a preprocessor define, converted to its GLSL spelling once
+     */
+    struct ShaderDefine {
+        std::string value;
+
+        ShaderDefine(int value);
+
+        ShaderDefine(uint32_t value);
+
+        ShaderDefine(float value);
+
+        ShaderDefine(bool value);
+
+        ShaderDefine(const char *value);
+
+        ShaderDefine(std::string value);
+
+        auto operator<=>(const ShaderDefine &) const = default;
+    };
+
+    /**
+     * Preprocessor defines of a shader variant, e.g. `ShaderDefines{{"BOARD_SIZE", 8}}`.
+     * Ordered by name, so equal sets always produce the same source.
+     */
+    using ShaderDefines = std::map<std::string, ShaderDefine>;
+
+    /**
+     * Make `source` available to shaders as `#include "name"`.
+     *
+     * `framework/frame_uniforms.glsl`, `framework/multi_draw.glsl` and `framework/materials.glsl` are always available.
+     */
+    void registerShaderInclude(const std::string &name, const std::string &source);
+
+    /**
+     * Insert a `#define` line for every define after the `#version` line, and replace every `#include "name"` line
+     * with the registered snippet. Each snippet is only included once.
+     */
+    std::string preprocessShader(const std::string &source, const ShaderDefines &defines = {});
+
+    /**
+     * Specialized programs of one pair of sources, compiled once per define set.
+     *
+     * The `ShaderCache` only saves the driver's compile across runs, and is keyed on the preprocessed source. This
+     * cache also saves preprocessing and linking within a run, and keeps one program object per permutation.
+     */
+    class ShaderVariants {
+        struct Variant {
+            PendingShader pendingShader;
+
+            /// Set once the program has been waited for
+            std::shared_ptr<Shader> shader;
+        };
+
+        std::string vertexShaderSource;
+        std::string fragmentShaderSource;
+
+        std::map<ShaderDefines, Variant> variants;
+
+    public:
+        ShaderVariants(std::string vertexShaderSource, std::string fragmentShaderSource);
+
+        /**
+         * Start compiling the program for `defines` in the background, unless it already has been
+         * @return The program being compiled, e.g. for its timing
+         */
+        PendingShader &compile(const ShaderDefines &defines = {});
+
+        /**
+         * @return Program compiled with `defines`, shared with every earlier request for the same set
+         */
+        std::shared_ptr<Shader> variant(const ShaderDefines &defines = {});
+    };
+}
+
+#endif //PROG2002_SHADERSOURCE_H
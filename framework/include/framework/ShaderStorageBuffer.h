@@ -0,0 +1,121 @@
+#ifndef PROG2002_SHADERSTORAGEBUFFER_H
+#define PROG2002_SHADERSTORAGEBUFFER_H
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cassert>
+#include "glad/glad.h"
+#include "DirtyRanges.h"
+#include "FrameStats.h"
+#include "RenderState.h"
+
+namespace framework {
+
+    /**
+     * A shader storage buffer object, for large or unsized arrays that do not fit in an uniform buffer.
+     * Elements need to comply with std430.
+     *
+     * Keeps a copy of its contents, so that changes can be uploaded as a few `glNamedBufferSubData` calls over only
+     * the elements that actually changed.
+     */
+    template<typename T>
+    struct ShaderStorageBuffer {
+        uint32_t storageBufferId;
+
+        /// Contents of the buffer as last written
+        std::vector<T> elements;
+
+        /// Elements changed since the last `flush`
+        DirtyRanges dirtyRanges;
+
+        ShaderStorageBuffer(uint32_t storageBufferId, std::vector<T> elements) :
+            storageBufferId(storageBufferId), elements(std::move(elements)) {};
+
+        ShaderStorageBuffer(ShaderStorageBuffer &&object) noexcept:
+            storageBufferId(object.storageBufferId),
+            elements(std::move(object.elements)),
+            dirtyRanges(std::move(object.dirtyRanges)) {
+            object.storageBufferId = 0;
+        }
+
+        ~ShaderStorageBuffer() {
+            if (storageBufferId) {
+                renderState().forgetBuffer(storageBufferId);
+                glDeleteBuffers(1, &storageBufferId);
+            }
+        }
+
+        /**
+         * Replace the contents with `data`, only elements that differ are uploaded
+         */
+        void updateData(const std::vector<T> &data) {
+            if (data.size() != elements.size()) {
+                // Size changed, reallocate the whole store
+                elements = data;
+                dirtyRanges.take();
+
+                glNamedBufferData(storageBufferId, data.size() * sizeof(T), data.data(), GL_DYNAMIC_DRAW);
+                countBufferUpload(data.size() * sizeof(T));
+
+                return;
+            }
+
+            dirtyRanges.markChanged(elements, data);
+            flush();
+        }
+
+        /**
+         * Overwrite elements starting at `first`, uploaded on the next `flush`
+         */
+        void setElements(uint32_t first, std::span<const T> data) {
+            assert(first + data.size() <= elements.size());
+
+            std::copy(data.begin(), data.end(), elements.begin() + first);
+            dirtyRanges.mark(first, first + data.size());
+        }
+
+        /**
+         * Upload every element changed since the last flush, adjacent changes are merged into one upload
+         */
+        void flush() {
+            for (auto [begin, end]: dirtyRanges.take()) {
+                glNamedBufferSubData(
+                    storageBufferId,
+                    (GLintptr) begin * sizeof(T),
+                    (GLsizeiptr) (end - begin) * sizeof(T),
+                    &elements[begin]
+                );
+                countBufferUpload((end - begin) * sizeof(T));
+            }
+        }
+
+        /**
+         * Range of the buffer that holds the data
+         */
+        [[nodiscard]] BufferRange range() const {
+            return {.bufferId = storageBufferId};
+        }
+
+        /**
+         * Bind to shader storage buffer binding `slot`
+         */
+        void bind(uint32_t slot) const {
+            renderState().bindShaderStorageBuffer(slot, range());
+        }
+
+        static ShaderStorageBuffer<T> create(
+            const std::vector<T> &data
+        ) {
+            uint32_t storageBufferId;
+            glCreateBuffers(1, &storageBufferId);
+            countBufferCreation();
+            glNamedBufferData(storageBufferId, data.size() * sizeof(T), data.data(), GL_DYNAMIC_DRAW);
+            countBufferUpload(data.size() * sizeof(T));
+
+            return ShaderStorageBuffer<T>(storageBufferId, data);
+        }
+    };
+}
+
+#endif //PROG2002_SHADERSTORAGEBUFFER_H
@@ -0,0 +1,246 @@
+#ifndef PROG2002_STREAMINGUNIFORMBUFFER_H
+#define PROG2002_STREAMINGUNIFORMBUFFER_H
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include "glad/glad.h"
+#include "DirtyRanges.h"
+#include "FrameStats.h"
+#include "RenderState.h"
+
+namespace framework {
+
+    /**
+     * An uniform buffer object for data that changes often, like once per frame.
+     *
+     * The buffer is split into a ring of slices that stay persistently mapped. Every `updateData` writes into the
+     * next slice while the GPU may still be reading the previous ones, so the CPU only has to wait if it gets more
+     * than `slicesAmount` updates ahead of the GPU. Only the elements that changed since a slice was last written are
+     * copied into it.
+     */
+    template<typename T>
+    struct StreamingUniformBuffer {
+        uint32_t uniformBufferId = 0;
+
+        /// Amount of elements in each slice
+        uint32_t elementsAmount;
+
+        /// Amount of slices in the ring
+        uint32_t slicesAmount;
+
+        /// Distance in bytes between the start of two slices, respects `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`
+        uint32_t sliceStride;
+
+        /// Persistently mapped memory of the whole buffer
+        std::byte *mapping;
+
+        /// Slice that was written most recently, which is the one draws read from
+        uint32_t currentSlice = 0;
+
+        /// Fence placed after the last commands that could read each slice, `nullptr` if none are pending
+        std::vector<GLsync> fences;
+
+        /// Latest contents of the buffer
+        std::vector<T> elements;
+
+        /// Elements each slice is missing, because they changed after the slice was last written
+        std::vector<DirtyRanges> pendingRanges;
+
+        /// Whether `elements` changed since the last `commit`
+        bool hasUncommittedChanges = false;
+
+        StreamingUniformBuffer(
+            uint32_t uniformBufferId,
+            uint32_t elementsAmount,
+            uint32_t slicesAmount,
+            uint32_t sliceStride,
+            std::byte *mapping,
+            std::vector<T> elements
+        ) : uniformBufferId(uniformBufferId),
+            elementsAmount(elementsAmount),
+            slicesAmount(slicesAmount),
+            sliceStride(sliceStride),
+            mapping(mapping),
+            fences(slicesAmount, nullptr),
+            elements(std::move(elements)),
+            pendingRanges(slicesAmount) {}
+
+        StreamingUniformBuffer(StreamingUniformBuffer &&object) noexcept:
+            uniformBufferId(object.uniformBufferId),
+            elementsAmount(object.elementsAmount),
+            slicesAmount(object.slicesAmount),
+            sliceStride(object.sliceStride),
+            mapping(object.mapping),
+            currentSlice(object.currentSlice),
+            fences(std::move(object.fences)),
+            elements(std::move(object.elements)),
+            pendingRanges(std::move(object.pendingRanges)),
+            hasUncommittedChanges(object.hasUncommittedChanges) {
+            object.uniformBufferId = 0;
+            object.mapping = nullptr;
+        }
+
+        ~StreamingUniformBuffer() {
+            for (auto fence: fences) {
+                if (fence) glDeleteSync(fence);
+            }
+
+            if (uniformBufferId) {
+                renderState().forgetBuffer(uniformBufferId);
+                glUnmapNamedBuffer(uniformBufferId);
+                glDeleteBuffers(1, &uniformBufferId);
+            }
+        }
+
+        StreamingUniformBuffer(const StreamingUniformBuffer &) = delete;
+
+        StreamingUniformBuffer &operator=(const StreamingUniformBuffer &) = delete;
+
+        /**
+         * Replace the contents with `data` and commit, draws issued after this will read the new data
+         */
+        void updateData(const std::vector<T> &data) {
+            // Only the first `elementsAmount` elements fit in a slice, the rest are ignored
+            assert(data.size() <= elementsAmount);
+
+            DirtyRanges changedRanges;
+            if (!changedRanges.markChanged(elements, data)) return;
+
+            for (auto [begin, end]: changedRanges.take()) {
+                markPending(begin, end);
+            }
+
+            commit();
+        }
+
+        /**
+         * Overwrite elements starting at `first`, visible to draws after the next `commit`
+         */
+        void setElements(uint32_t first, std::span<const T> data) {
+            assert(first + data.size() <= elementsAmount);
+
+            std::copy(data.begin(), data.end(), elements.begin() + first);
+            markPending(first, first + data.size());
+        }
+
+        /**
+         * Write pending changes into the next slice and make it current
+         */
+        void commit() {
+            if (!hasUncommittedChanges) return;
+            hasUncommittedChanges = false;
+
+            // Every command issued until now reads from the current slice
+            fenceSlice(currentSlice);
+
+            currentSlice = (currentSlice + 1) % slicesAmount;
+            waitForSlice(currentSlice);
+
+            for (auto [begin, end]: pendingRanges[currentSlice].take()) {
+                std::memcpy(sliceData(currentSlice) + begin * sizeof(T), &elements[begin], (end - begin) * sizeof(T));
+                countBufferUpload((end - begin) * sizeof(T));
+            }
+        }
+
+        /**
+         * Range of the buffer that holds the current slice, stays valid until the next `commit`
+         */
+        [[nodiscard]] BufferRange range() const {
+            return {
+                .bufferId = uniformBufferId,
+                .offset = (GLintptr) currentSlice * sliceStride,
+                .size = (GLsizeiptr) elementsAmount * sizeof(T)
+            };
+        }
+
+        /**
+         * Bind the current slice to uniform buffer binding `slot`
+         */
+        void bind(uint32_t slot) const {
+            renderState().bindUniformBuffer(slot, range());
+        }
+
+        static StreamingUniformBuffer<T> create(
+            const std::vector<T> &data,
+            uint32_t slicesAmount = 3
+        ) {
+            int32_t offsetAlignment;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+            auto elementsAmount = (uint32_t) data.size();
+            uint32_t sliceSize = elementsAmount * sizeof(T);
+            uint32_t sliceStride = (sliceSize + offsetAlignment - 1) / offsetAlignment * offsetAlignment;
+
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+            uint32_t uniformBufferId;
+            glCreateBuffers(1, &uniformBufferId);
+            countBufferCreation();
+            glNamedBufferStorage(uniformBufferId, (GLsizeiptr) sliceStride * slicesAmount, nullptr, flags);
+
+            auto mapping = (std::byte *) glMapNamedBufferRange(
+                uniformBufferId,
+                0,
+                (GLsizeiptr) sliceStride * slicesAmount,
+                flags
+            );
+
+            // No slice is in use yet, so every slice starts out with the initial data
+            for (uint32_t slice = 0; slice < slicesAmount; ++slice) {
+                std::memcpy(mapping + (size_t) slice * sliceStride, data.data(), sliceSize);
+            }
+            countBufferUpload(sliceSize * slicesAmount);
+
+            auto uniformBuffer = StreamingUniformBuffer<T>(
+                uniformBufferId,
+                elementsAmount,
+                slicesAmount,
+                sliceStride,
+                mapping,
+                data
+            );
+
+            return uniformBuffer;
+        }
+
+    private:
+        void markPending(uint32_t begin, uint32_t end) {
+            for (auto &ranges: pendingRanges) {
+                ranges.mark(begin, end);
+            }
+
+            hasUncommittedChanges = true;
+        }
+
+        [[nodiscard]] std::byte *sliceData(uint32_t slice) const {
+            return mapping + (size_t) slice * sliceStride;
+        }
+
+        void fenceSlice(uint32_t slice) {
+            if (fences[slice]) glDeleteSync(fences[slice]);
+            fences[slice] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        /**
+         * Block until the GPU has finished every command that could read `slice`
+         */
+        void waitForSlice(uint32_t slice) {
+            auto fence = fences[slice];
+            if (!fence) return;
+
+            GLenum waitResult;
+            do {
+                waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+            } while (waitResult == GL_TIMEOUT_EXPIRED);
+
+            glDeleteSync(fence);
+            fences[slice] = nullptr;
+        }
+    };
+}
+
+#endif //PROG2002_STREAMINGUNIFORMBUFFER_H
@@ -3,7 +3,14 @@
 
 #include <cstdint>
 #include <string>
-#include "stb_image.h"
+#include <cstddef>
+#include <span>
+#include <ostream>
+#include <memory>
+#include <array>
+#include <optional>
+#include "Mipmaps.h"
+#include "ImageProcessing.h"
 
 namespace framework {
     enum class Filtering {
@@ -13,19 +20,100 @@ namespace framework {
     };
 
     enum class Wrapping {
-        Repeat
+        Repeat,
+
+        /// Coordinates outside [0, 1] use the edge pixels, avoids seams between cubemap faces
+        ClampToEdge,
+
+        /// Every other repetition is mirrored
+        MirroredRepeat,
+
+        /// Mirrored once around 0, then clamped to the edge
+        MirrorClampToEdge
+    };
+
+    enum class TextureType {
+        Texture2D,
+
+        /// Six square faces, all filled with the same image
+        Cubemap
+    };
+
+    /// How the six faces of a cubemap are arranged in one image
+    enum class CubemapLayout {
+        /// The whole image is used for every face
+        SameOnEveryFace,
+
+        /// 4x3 faces, -X +Z +X -Z in the middle row with +Y above and -Y below +Z
+        HorizontalCross,
+
+        /// 3x4 faces, -X +Z +X in the second row with +Y above +Z, and -Y then an upside down -Z below it
+        VerticalCross,
+
+        /// 6x1 faces in the order +X -X +Y -Y +Z -Z
+        HorizontalStrip,
+
+        /// 1x6 faces in the order +X -X +Y -Y +Z -Z
+        VerticalStrip
+    };
+
+    /**
+     * Pixels of an image already copied into a pixel unpack buffer, such as a region of a `PixelUploadRing`.
+     * Uploading them only queues a copy on the GPU, so the upload call does not wait on any copy.
+     */
+    struct StagedPixels {
+        uint32_t pixelBufferId;
+
+        /// Offset of the pixels from the start of the buffer
+        size_t offset;
+    };
+
+    /**
+     * Memory held by a texture
+     */
+    struct TextureMemory {
+        /// Decoded pixels still held in CPU memory, 0 once they are released after the upload
+        size_t cpuBytes;
+
+        /// Size of the texture storage on the GPU
+        size_t gpuBytes;
+    };
+
+    std::ostream &operator<<(std::ostream &output, const TextureMemory &memory);
+
+    struct ImageDeleter {
+        void operator()(uint8_t *pixels) const;
+    };
+
+    /**
+     * Decoded RGBA8 image, freed when it goes out of scope
+     */
+    struct Image {
+        int width;
+        int height;
+        std::unique_ptr<uint8_t, ImageDeleter> pixels;
+
+        /// Whether the file had an alpha channel, textures of opaque images are stored without one
+        bool hasAlpha = true;
+
+        ColorSpace colorSpace = ColorSpace::Linear;
     };
 
     class Texture {
     private:
         uint32_t id;
-        stbi_uc *pixels;
+        TextureMemory textureMemory;
 
     public:
-        Texture(uint32_t id, stbi_uc *pixels);
+        Texture(uint32_t id, TextureMemory memory);
 
         Texture(Texture &&texture) noexcept;
 
+        /**
+         * Delete the current texture and take over `texture`, used to swap in a texture that finished loading
+         */
+        Texture &operator=(Texture &&texture) noexcept;
+
         ~Texture();
 
         Texture(const Texture &) = delete;
@@ -33,19 +121,135 @@ namespace framework {
         Texture &operator=(const Texture &) = delete;
 
         void bind() const;
+
+        [[nodiscard]] uint32_t textureId() const;
+
+        [[nodiscard]] const TextureMemory &memory() const;
     };
 
+    /**
+     * Decode an image file to RGBA8, does not use OpenGL so it can run on any thread
+     */
+    Image decodeImage(const std::string &path);
+
+    /**
+     * Decode an image file held in memory, such as an asset of a mapped `AssetPack`
+     */
+    Image decodeImage(std::span<const std::byte> data);
+
+    /**
+     * Run the CPU stage of `processing` over the pixels, with the SIMD kernels of `ImageProcessing.h`
+     */
+    void processImage(Image &image, const ImageProcessing &processing);
+
+    /**
+     * Create a texture from `image` on the current context.
+     * With `Filtering::LinearMipmap` a full mip chain is allocated and filled as chosen by `mipmaps`.
+     *
+     * With `staged` the pixels are read from a pixel unpack buffer, and `image.pixels` may already be freed. Only
+     * `Mipmaps::Gpu` can fill the mip chain of staged pixels, the other filters read the pixels on the CPU.
+     */
+    Texture createTexture(
+        const Image &image,
+        TextureType type,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu,
+        const std::optional<StagedPixels> &staged = std::nullopt
+    );
+
+    /**
+     * Create a cubemap from `image` on the current context, with the faces cut out as arranged by `layout`.
+     * Staged pixels work like with `createTexture`, but only with `CubemapLayout::SameOnEveryFace`.
+     */
+    Texture createCubemap(
+        const Image &image,
+        CubemapLayout layout,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu,
+        const std::optional<StagedPixels> &staged = std::nullopt
+    );
+
+    /**
+     * Create a `GL_TEXTURE_2D_ARRAY` with one layer per image, so one draw can pick between many textures by layer.
+     * Every image needs the same size.
+     */
+    Texture createTextureArray(
+        std::span<const Image> images,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu
+    );
+
+    /**
+     * A single gray pixel, to draw with until the actual texture is loaded
+     */
+    Texture createPlaceholderTexture(TextureType type);
+
+    /**
+     * Decode and upload an image, the decoded pixels are freed as soon as they are uploaded.
+     * With `Filtering::LinearMipmap` a full mip chain is allocated and filled as chosen by `mipmaps`.
+     * The pixels go through `processing` first, and the storage format follows its color space.
+     */
     Texture loadTexture(
         const std::string &path,
         Filtering filtering = Filtering::LinearMipmap,
-        Wrapping wrapping = Wrapping::Repeat
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu,
+        const ImageProcessing &processing = {}
+    );
+
+    /**
+     * Like `loadTexture`, but decodes from an image file held in memory
+     */
+    Texture loadTexture(
+        std::span<const std::byte> data,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu,
+        const ImageProcessing &processing = {}
     );
 
     Texture loadCubemap(
         const std::string &path,
+        CubemapLayout layout = CubemapLayout::SameOnEveryFace,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu,
+        const ImageProcessing &processing = {}
+    );
+
+    /**
+     * Load a block compressed texture made by the texture compressor tool, with the mip levels it stores.
+     * Skips image decoding, and the texture stays compressed on the GPU.
+     */
+    Texture loadCompressedTexture(
+        const std::string &path,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat
+    );
+
+    /**
+     * Like `loadCompressedTexture`, but reads the file from memory. The blocks are uploaded straight from `data`
+     * without being copied, so from a mapped `AssetPack` they go from the page cache to the driver.
+     */
+    Texture loadCompressedTexture(
+        std::span<const std::byte> data,
         Filtering filtering = Filtering::LinearMipmap,
         Wrapping wrapping = Wrapping::Repeat
     );
+
+    /**
+     * Load a cubemap from one file per face, in the order +X -X +Y -Y +Z -Z. The faces are decoded in parallel and
+     * uploaded with a single call.
+     */
+    Texture loadCubemap(
+        const std::array<std::string, 6> &facePaths,
+        Filtering filtering = Filtering::LinearMipmap,
+        Wrapping wrapping = Wrapping::Repeat,
+        Mipmaps mipmaps = Mipmaps::Gpu
+    );
 }
 
 #endif //PROG2002_TEXTURE_H
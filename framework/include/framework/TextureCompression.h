@@ -0,0 +1,85 @@
+#ifndef PROG2002_TEXTURECOMPRESSION_H
+#define PROG2002_TEXTURECOMPRESSION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace framework {
+    /// Block compressed formats, every block holds 4x4 pixels
+    enum class CompressedFormat : uint32_t {
+        /// 8 bytes per block, RGB without alpha
+        Bc1 = 1,
+
+        /// 16 bytes per block, RGB with interpolated alpha
+        Bc3 = 3
+    };
+
+    /**
+     * Blocks of one mip level
+     */
+    struct CompressedLevel {
+        int width;
+        int height;
+        std::vector<uint8_t> blocks;
+    };
+
+    /**
+     * A block compressed texture with prebuilt mip levels, as stored by the texture compressor tool
+     */
+    struct CompressedTexture {
+        CompressedFormat format;
+        std::vector<CompressedLevel> levels;
+    };
+
+    /**
+     * Blocks of one mip level, read in place from the memory of a whole file
+     */
+    struct CompressedLevelView {
+        int width;
+        int height;
+        std::span<const uint8_t> blocks;
+    };
+
+    /**
+     * A compressed texture whose levels point into memory it does not own, such as a mapped asset pack
+     */
+    struct CompressedTextureView {
+        CompressedFormat format;
+        std::vector<CompressedLevelView> levels;
+    };
+
+    /**
+     * @return Size in bytes of every block of a `width` x `height` level
+     */
+    size_t compressedSize(CompressedFormat format, int width, int height);
+
+    /**
+     * @return OpenGL internal format of `format`
+     */
+    uint32_t compressedGlFormat(CompressedFormat format);
+
+    /**
+     * Compress RGBA8 pixels into blocks, blocks that stick out of the image repeat its last row and column
+     */
+    std::vector<uint8_t> compressPixels(const uint8_t *pixels, int width, int height, CompressedFormat format);
+
+    /**
+     * Write `texture` to `path`.
+     *
+     * The file starts with a header of identifier, format, size and level amount, followed by an index of the offset
+     * and size of every level. Level data follows, each level aligned to 16 bytes.
+     */
+    void writeCompressedTexture(const std::string &path, const CompressedTexture &texture);
+
+    CompressedTexture readCompressedTexture(const std::string &path);
+
+    /**
+     * Read the header and level index of a compressed texture file held in memory, without copying the blocks
+     */
+    CompressedTextureView parseCompressedTexture(std::span<const std::byte> data);
+}
+
+#endif //PROG2002_TEXTURECOMPRESSION_H
@@ -0,0 +1,149 @@
+#ifndef PROG2002_TEXTURESTREAMER_H
+#define PROG2002_TEXTURESTREAMER_H
+
+#include <string>
+#include <span>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "Texture.h"
+#include "PixelUploadRing.h"
+
+namespace framework {
+    /**
+     * Loads textures in the background, so startup does not wait on decoding images.
+     *
+     * Images are decoded on a pool of worker threads and uploaded by one thread through a context shared with the
+     * window. `load` returns a placeholder right away, which `update` swaps for the actual texture once the GPU is
+     * done with the upload.
+     *
+     * The decode threads copy the pixels into a `PixelUploadRing` and free them, so the upload thread only queues
+     * copies out of the ring on the GPU. Images that are larger than the ring, or get mip levels filtered on the CPU,
+     * are uploaded from CPU memory instead.
+     */
+    class TextureStreamer {
+    public:
+        /// Size of the ring decoded pixels are staged in
+        static const size_t STAGING_BYTES = 64 * 1024 * 1024;
+
+    private:
+        struct Request {
+            std::string path;
+
+            /// Image file in memory, decoded instead of `path` when not empty
+            std::span<const std::byte> data;
+
+            TextureType type;
+            Filtering filtering;
+            Wrapping wrapping;
+            Mipmaps mipmaps;
+
+            /// Placeholder handed out by `load`, dropped requests are still loaded but never swapped in
+            std::weak_ptr<Texture> texture;
+        };
+
+        struct DecodedImage {
+            Request request;
+
+            /// Pixels are freed once staged
+            Image image;
+
+            /// Region of the ring holding the pixels, uploaded from `image` if empty
+            std::optional<PixelUploadRing::Region> stagedPixels;
+        };
+
+        struct UploadedTexture {
+            Request request;
+            Texture texture;
+
+            /// Signaled once the GPU finished the upload
+            GLsync fence;
+        };
+
+        GLFWwindow *uploadContext;
+        PixelUploadRing pixelUploadRing;
+
+        std::vector<std::thread> decodeThreads;
+        std::thread uploadThread;
+
+        std::mutex mutex;
+        std::condition_variable decodeCondition;
+        std::condition_variable uploadCondition;
+
+        std::deque<Request> decodeQueue;
+        std::deque<DecodedImage> uploadQueue;
+        std::vector<UploadedTexture> uploadedTextures;
+
+        /// Requests that have not been swapped in yet
+        uint32_t pendingAmount = 0;
+
+        bool isStopping = false;
+
+    public:
+        /**
+         * Start the worker threads, has to be called from the main thread with the context of `window` current
+         * @param decodeThreadsAmount Amount of threads decoding images, every hardware thread but one by default
+         */
+        explicit TextureStreamer(GLFWwindow *window, uint32_t decodeThreadsAmount = 0);
+
+        /**
+         * Stop the worker threads and delete textures that were never swapped in. Has to run on the main thread with
+         * the context of the window current, so before the window is destroyed.
+         */
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer &) = delete;
+
+        TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+        /**
+         * Queue an image to be loaded
+         * @return Placeholder texture, replaced by the image during a later `update`
+         */
+        std::shared_ptr<Texture> load(
+            const std::string &path,
+            TextureType type = TextureType::Texture2D,
+            Filtering filtering = Filtering::LinearMipmap,
+            Wrapping wrapping = Wrapping::Repeat,
+            Mipmaps mipmaps = Mipmaps::Gpu
+        );
+
+        /**
+         * Queue an image file held in memory to be loaded, such as an asset of a mapped `AssetPack`.
+         * `data` has to stay valid until the texture is swapped in or the streamer is destroyed.
+         * @return Placeholder texture, replaced by the image during a later `update`
+         */
+        std::shared_ptr<Texture> load(
+            std::span<const std::byte> data,
+            TextureType type = TextureType::Texture2D,
+            Filtering filtering = Filtering::LinearMipmap,
+            Wrapping wrapping = Wrapping::Repeat,
+            Mipmaps mipmaps = Mipmaps::Gpu
+        );
+
+        /**
+         * Swap in every texture the GPU finished uploading, call once per frame from the main thread
+         */
+        void update();
+
+        /**
+         * @return Whether every requested texture has been swapped in
+         */
+        [[nodiscard]] bool isIdle();
+
+    private:
+        std::shared_ptr<Texture> queue(Request request);
+
+        void decodeImages();
+
+        void uploadImages();
+    };
+}
+
+#endif //PROG2002_TEXTURESTREAMER_H
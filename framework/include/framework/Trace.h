@@ -0,0 +1,153 @@
+#ifndef PROG2002_TRACE_H
+#define PROG2002_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+
+#define PROG2002_TRACE_CONCAT_INNER(a, b) a##b
+#define PROG2002_TRACE_CONCAT(a, b) PROG2002_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * Record the rest of the enclosing block as a trace event called `name`, which has to outlive the program, like a
+ * string literal. While tracing is disabled this costs a single predictable branch.
+ */
+#define PROG2002_TRACE_SCOPE(name) \
+    framework::TraceScope PROG2002_TRACE_CONCAT(traceScope, __LINE__)(name)
+
+/**
+ * Record the rest of the enclosing function as a trace event named after the function
+ */
+#define PROG2002_TRACE_FUNCTION() PROG2002_TRACE_SCOPE(__func__)
+
+namespace framework {
+    /// Set by `enableTracing`, read by every traced scope
+    inline std::atomic<bool> isTracingEnabled = false;
+
+    [[nodiscard]] inline bool isTracing() {
+        return isTracingEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Time trace events are measured in, nanoseconds of a steady clock
+     */
+    uint64_t traceTime();
+
+    /**
+     * A finished scope on one timeline
+     */
+    struct TraceEvent {
+        const char *name;
+        uint64_t start;
+        uint64_t duration;
+    };
+
+    /**
+     * Events of one timeline, such as a thread or the GPU.
+     *
+     * Only one thread records into a buffer, without locking. Events are stored in chunks that are never moved, and
+     * published by the event count, so the trace can be written from another thread while events are recorded.
+     */
+    class TraceBuffer {
+    public:
+        static constexpr size_t CHUNK_EVENTS = 4096;
+        static constexpr size_t MAX_CHUNKS = 1024;
+
+    private:
+        std::string name;
+        uint32_t trackId;
+
+        std::array<std::atomic<TraceEvent *>, MAX_CHUNKS> chunks{};
+        std::atomic<size_t> eventsAmount = 0;
+
+        /// Events not recorded because every chunk was full
+        std::atomic<size_t> droppedEvents = 0;
+
+    public:
+        TraceBuffer(std::string name, uint32_t trackId);
+
+        ~TraceBuffer();
+
+        TraceBuffer(const TraceBuffer &) = delete;
+
+        TraceBuffer &operator=(const TraceBuffer &) = delete;
+
+        /**
+         * Add an event, only to be called by the thread that owns the buffer
+         */
+        void record(const TraceEvent &event);
+
+        void rename(std::string newName);
+
+        /**
+         * Write the name of the timeline and every event recorded so far as Chrome `trace_event` objects, each preceded
+         * by a comma
+         */
+        void writeEvents(std::ostream &output, uint64_t epoch) const;
+
+        [[nodiscard]] const std::string &trackName() const;
+
+        [[nodiscard]] size_t droppedEventsAmount() const;
+    };
+
+    /**
+     * Times from construction until destruction, see `PROG2002_TRACE_SCOPE`
+     */
+    class TraceScope {
+        const char *name = nullptr;
+        uint64_t start = 0;
+
+    public:
+        explicit TraceScope(const char *name) {
+            if (isTracing()) [[unlikely]] {
+                this->name = name;
+                start = traceTime();
+            }
+        }
+
+        ~TraceScope();
+
+        TraceScope(const TraceScope &) = delete;
+
+        TraceScope &operator=(const TraceScope &) = delete;
+    };
+
+    /**
+     * Start recording trace events, written to `path` as Chrome `trace_event` JSON when the program exits. Open it
+     * in `chrome://tracing` or Perfetto. Names the calling thread "Main"
+     */
+    void enableTracing(const std::filesystem::path &path);
+
+    /**
+     * Write every event recorded so far to the path given to `enableTracing`, overwriting the file
+     */
+    void writeTrace();
+
+    void writeTrace(std::ostream &output);
+
+    /**
+     * @return Buffer of the calling thread, created on first use
+     */
+    TraceBuffer &threadTraceBuffer();
+
+    /**
+     * Name the timeline of the calling thread
+     */
+    void setTraceThreadName(std::string name);
+
+    /**
+     * @return Buffer of a timeline that is not a thread, such as the GPU, created on first use. Only one thread may
+     * record into it
+     */
+    TraceBuffer &traceTrack(const std::string &name);
+
+    /**
+     * @return Copy of `name` that lives until the program exits, for event names that are not literals
+     */
+    const char *traceName(const std::string &name);
+}
+
+#endif //PROG2002_TRACE_H
@@ -2,29 +2,105 @@
 #define PROG2002_UNIFORMBUFFER_H
 
 #include <vector>
+#include <span>
+#include <algorithm>
+#include <cassert>
 #include "glad/glad.h"
+#include "DirtyRanges.h"
+#include "FrameStats.h"
+#include "RenderState.h"
 
 namespace framework {
 
     /**
      * An uniform buffer object
+     *
+     * Keeps a copy of its contents, so that changes can be uploaded as a few `glNamedBufferSubData` calls over only
+     * the elements that actually changed.
      */
     template<typename T>
     struct UniformBuffer {
         uint32_t uniformBufferId;
 
-        explicit UniformBuffer(uint32_t uniformBufferId) : uniformBufferId(uniformBufferId) {};
+        /// Contents of the buffer as last written
+        std::vector<T> elements;
 
-        UniformBuffer(UniformBuffer &&object) noexcept: uniformBufferId(object.uniformBufferId) {
+        /// Elements changed since the last `flush`
+        DirtyRanges dirtyRanges;
+
+        UniformBuffer(uint32_t uniformBufferId, std::vector<T> elements) :
+            uniformBufferId(uniformBufferId), elements(std::move(elements)) {};
+
+        UniformBuffer(UniformBuffer &&object) noexcept:
+            uniformBufferId(object.uniformBufferId),
+            elements(std::move(object.elements)),
+            dirtyRanges(std::move(object.dirtyRanges)) {
             object.uniformBufferId = 0;
         }
 
         ~UniformBuffer() {
-            if (uniformBufferId) glDeleteBuffers(1, &uniformBufferId);
+            if (uniformBufferId) {
+                renderState().forgetBuffer(uniformBufferId);
+                glDeleteBuffers(1, &uniformBufferId);
+            }
         }
 
-        void updateData(const std::vector<T> &data) const {
-            glNamedBufferData(uniformBufferId, data.size() * sizeof(T), data.data(), GL_DYNAMIC_DRAW);
+        /**
+         * Replace the contents with `data`, only elements that differ are uploaded
+         */
+        void updateData(const std::vector<T> &data) {
+            if (data.size() != elements.size()) {
+                // Size changed, reallocate the whole store
+                elements = data;
+                dirtyRanges.take();
+
+                glNamedBufferData(uniformBufferId, data.size() * sizeof(T), data.data(), GL_DYNAMIC_DRAW);
+                countBufferUpload(data.size() * sizeof(T));
+
+                return;
+            }
+
+            dirtyRanges.markChanged(elements, data);
+            flush();
+        }
+
+        /**
+         * Overwrite elements starting at `first`, uploaded on the next `flush`
+         */
+        void setElements(uint32_t first, std::span<const T> data) {
+            assert(first + data.size() <= elements.size());
+
+            std::copy(data.begin(), data.end(), elements.begin() + first);
+            dirtyRanges.mark(first, first + data.size());
+        }
+
+        /**
+         * Upload every element changed since the last flush, adjacent changes are merged into one upload
+         */
+        void flush() {
+            for (auto [begin, end]: dirtyRanges.take()) {
+                glNamedBufferSubData(
+                    uniformBufferId,
+                    (GLintptr) begin * sizeof(T),
+                    (GLsizeiptr) (end - begin) * sizeof(T),
+                    &elements[begin]
+                );
+                countBufferUpload((end - begin) * sizeof(T));
+            }
+        }
+
+        /**
+         * Range of the buffer that holds the data
+         */
+        [[nodiscard]] BufferRange range() const {
+            return {.bufferId = uniformBufferId};
+        }
+
+        /**
+         * Bind to uniform buffer binding `slot`
+         */
+        void bind(uint32_t slot) const {
+            renderState().bindUniformBuffer(slot, range());
         }
 
         static UniformBuffer<T> create(
@@ -32,9 +108,11 @@ namespace framework {
         ) {
             uint32_t uniformBufferId;
             glCreateBuffers(1, &uniformBufferId);
+            countBufferCreation();
             glNamedBufferData(uniformBufferId, data.size() * sizeof(T), data.data(), GL_DYNAMIC_DRAW);
+            countBufferUpload(data.size() * sizeof(T));
 
-            return UniformBuffer<T>(uniformBufferId);
+            return UniformBuffer<T>(uniformBufferId, data);
         }
     };
 }
@@ -12,6 +12,9 @@
 #include "Shader.h"
 #include "IndexBuffer.h"
 #include "VertexBuffer.h"
+#include "RenderState.h"
+#include "DrawCommand.h"
+#include "Trace.h"
 
 namespace framework {
     /**
@@ -29,7 +32,16 @@ namespace framework {
 
         /// `true` if the parameter represents a normalized integer (type must be an integer type). `false` otherwise.
         bool normalize;
+
+        /// `true` if the shader reads the attribute as an integer (`int`, `ivec2`, ...), type must be an integer type
+        bool isInteger;
     };
+
+    /// Buffer binding used for per-vertex attributes
+    const uint32_t VERTEX_BUFFER_BINDING = 0;
+
+    /// Buffer binding used for per-instance attributes
+    const uint32_t INSTANCE_BUFFER_BINDING = 1;
     
     /**
      * An vertex array object that can be drawed
@@ -43,6 +55,9 @@ namespace framework {
 
         uint32_t vertexArrayId = 0;
 
+        /// Amount of attribute locations in use
+        uint32_t attributesAmount = 0;
+
         VertexArray(
             std::shared_ptr<Shader> shader,
             std::vector<VertexAttribute> attributes,
@@ -52,25 +67,12 @@ namespace framework {
             glCreateVertexArrays(1, &vertexArrayId);
 
             // Vertex attributes
-            for (int attributeIndex = 0; attributeIndex < attributes.size(); ++attributeIndex) {
-                VertexAttribute vertexAttribute = attributes[attributeIndex];
-
-                glEnableVertexArrayAttrib(vertexArrayId, attributeIndex);
-                glVertexArrayAttribBinding(vertexArrayId, attributeIndex, 0);
-                glVertexArrayAttribFormat(
-                    vertexArrayId,
-                    attributeIndex,
-                    (int32_t) vertexAttribute.size,
-                    vertexAttribute.type,
-                    vertexAttribute.normalize,
-                    vertexAttribute.offset
-                );
-            }
+            addAttributes(attributes, VERTEX_BUFFER_BINDING);
 
             // Bind vertex buffer
             glVertexArrayVertexBuffer(
                 vertexArrayId,
-                0,
+                VERTEX_BUFFER_BINDING,
                 this->vertexBuffer.vertexBufferId,
                 0,
                 sizeof(VertexType)
@@ -87,36 +89,97 @@ namespace framework {
             shader(std::move(object.shader)),
             vertexBuffer(std::move(object.vertexBuffer)),
             indexBuffer(std::move(object.indexBuffer)),
-            vertexArrayId(object.vertexArrayId) {
+            vertexArrayId(object.vertexArrayId),
+            attributesAmount(object.attributesAmount) {
             object.vertexArrayId = 0;
         }
 
         ~VertexArray() {
-            if (vertexArrayId) glDeleteVertexArrays(1, &vertexArrayId);
+            if (vertexArrayId) {
+                renderState().forgetVertexArray(vertexArrayId);
+                glDeleteVertexArrays(1, &vertexArrayId);
+            }
         }
 
-        void draw(GLenum drawMode = GL_TRIANGLES) const {
-            glUseProgram(shader->id);
-            glBindVertexArray(vertexArrayId);
+        /**
+         * Read per-instance attributes from `instanceBuffer`, advancing to the next element every `divisor` instances.
+         * The attributes get the locations following the per-vertex attributes, and `instanceBuffer` must outlive
+         * the vertex array.
+         */
+        template<typename InstanceType>
+        void setInstanceBuffer(
+            const VertexBuffer<InstanceType> &instanceBuffer,
+            const std::vector<VertexAttribute> &instanceAttributes,
+            uint32_t divisor = 1
+        ) {
+            addAttributes(instanceAttributes, INSTANCE_BUFFER_BINDING);
 
-            if (indexBuffer.has_value()) {
-                glDrawElements(drawMode, indexBuffer->elementsAmount, GL_UNSIGNED_INT, nullptr);
-            } else {
-                glDrawArrays(drawMode, 0, vertexBuffer.verticesAmount);
-            }
+            glVertexArrayVertexBuffer(
+                vertexArrayId,
+                INSTANCE_BUFFER_BINDING,
+                instanceBuffer.vertexBufferId,
+                0,
+                sizeof(InstanceType)
+            );
+            glVertexArrayBindingDivisor(vertexArrayId, INSTANCE_BUFFER_BINDING, divisor);
+        }
+
+        /**
+         * Create a command that draws this vertex array, to add state to and submit to a `DrawQueue`
+         */
+        [[nodiscard]] DrawCommand drawCommand(uint32_t instances = 1, GLenum drawMode = GL_TRIANGLES) const {
+            return {
+                .shader = shader.get(),
+                .vertexArrayId = vertexArrayId,
+                .drawMode = drawMode,
+                .elementsAmount = indexBuffer.has_value() ? indexBuffer->elementsAmount : vertexBuffer.verticesAmount,
+                .isIndexed = indexBuffer.has_value(),
+                .instances = instances
+            };
+        }
+
+        void draw(GLenum drawMode = GL_TRIANGLES) const {
+            PROG2002_TRACE_SCOPE("VertexArray::draw");
+            drawCommand(1, drawMode).issue();
         }
 
         /**
          * Draw with given amount of instances, and use `gl_InstanceID` in shader to differentiate instances
          */
         void drawInstanced(uint32_t instances, GLenum drawMode = GL_TRIANGLES) const {
-            glUseProgram(shader->id);
-            glBindVertexArray(vertexArrayId);
+            PROG2002_TRACE_SCOPE("VertexArray::drawInstanced");
+            drawCommand(instances, drawMode).issue();
+        }
 
-            if (indexBuffer.has_value()) {
-                glDrawElementsInstanced(drawMode, indexBuffer->elementsAmount, GL_UNSIGNED_INT, nullptr, instances);
-            } else {
-                glDrawArraysInstanced(drawMode, 0, vertexBuffer.verticesAmount, instances);
+    private:
+        /**
+         * Enable `attributes` at the next free locations, reading from buffer binding `binding`
+         */
+        void addAttributes(const std::vector<VertexAttribute> &attributes, uint32_t binding) {
+            for (auto &vertexAttribute: attributes) {
+                uint32_t attributeIndex = attributesAmount++;
+
+                glEnableVertexArrayAttrib(vertexArrayId, attributeIndex);
+                glVertexArrayAttribBinding(vertexArrayId, attributeIndex, binding);
+
+                if (vertexAttribute.isInteger) {
+                    glVertexArrayAttribIFormat(
+                        vertexArrayId,
+                        attributeIndex,
+                        (int32_t) vertexAttribute.size,
+                        vertexAttribute.type,
+                        vertexAttribute.offset
+                    );
+                } else {
+                    glVertexArrayAttribFormat(
+                        vertexArrayId,
+                        attributeIndex,
+                        (int32_t) vertexAttribute.size,
+                        vertexAttribute.type,
+                        vertexAttribute.normalize,
+                        vertexAttribute.offset
+                    );
+                }
             }
         }
     };
@@ -3,36 +3,98 @@
 
 #include <cstdint>
 #include <vector>
+#include <span>
+#include <algorithm>
+#include <cassert>
 #include "glad/glad.h"
+#include "DirtyRanges.h"
+#include "FrameStats.h"
 
 namespace framework {
+    /// How often the contents of a buffer will change
+    enum class BufferUsage {
+        /// Written once at creation
+        Static,
+
+        /// Updated after creation, keeps a copy of the contents so only changed elements are uploaded
+        Dynamic
+    };
+
     /// OpenGL vertex buffer
     template<typename VertexType>
     struct VertexBuffer {
         const uint32_t verticesAmount;
         uint32_t vertexBufferId = 0;
 
-        explicit VertexBuffer(std::vector<VertexType> vertices) : verticesAmount(vertices.size()) {
+        /// Contents of the buffer as last written, only kept for `BufferUsage::Dynamic`
+        std::vector<VertexType> vertices;
+
+        /// Vertices changed since the last `flush`
+        DirtyRanges dirtyRanges;
+
+        explicit VertexBuffer(std::vector<VertexType> vertices, BufferUsage usage = BufferUsage::Static) :
+            verticesAmount(vertices.size()) {
             glCreateBuffers(1, &vertexBufferId);
+            countBufferCreation();
 
             glNamedBufferData(
                 vertexBufferId,
                 vertices.size() * sizeof(VertexType),
                 vertices.data(),
-                GL_STATIC_DRAW
+                usage == BufferUsage::Dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW
             );
+            countBufferUpload(vertices.size() * sizeof(VertexType));
+
+            if (usage == BufferUsage::Dynamic) this->vertices = std::move(vertices);
         };
 
         // Move constructor
         VertexBuffer(VertexBuffer &&object) noexcept:
             verticesAmount(object.verticesAmount),
-            vertexBufferId(object.vertexBufferId) {
+            vertexBufferId(object.vertexBufferId),
+            vertices(std::move(object.vertices)),
+            dirtyRanges(std::move(object.dirtyRanges)) {
             object.vertexBufferId = 0;
         }
 
         ~VertexBuffer() {
             if (vertexBufferId) glDeleteBuffers(1, &vertexBufferId);
         }
+
+        /**
+         * Replace the contents with `data`, only vertices that differ are uploaded. Requires `BufferUsage::Dynamic`
+         */
+        void updateVertices(const std::vector<VertexType> &data) {
+            assert(vertices.size() == verticesAmount && data.size() == verticesAmount);
+
+            dirtyRanges.markChanged(vertices, data);
+            flush();
+        }
+
+        /**
+         * Overwrite vertices starting at `first`, uploaded on the next `flush`. Requires `BufferUsage::Dynamic`
+         */
+        void setVertices(uint32_t first, std::span<const VertexType> data) {
+            assert(vertices.size() == verticesAmount && first + data.size() <= verticesAmount);
+
+            std::copy(data.begin(), data.end(), vertices.begin() + first);
+            dirtyRanges.mark(first, first + data.size());
+        }
+
+        /**
+         * Upload every vertex changed since the last flush, adjacent changes are merged into one upload
+         */
+        void flush() {
+            for (auto [begin, end]: dirtyRanges.take()) {
+                glNamedBufferSubData(
+                    vertexBufferId,
+                    (GLintptr) begin * sizeof(VertexType),
+                    (GLsizeiptr) (end - begin) * sizeof(VertexType),
+                    &vertices[begin]
+                );
+                countBufferUpload((end - begin) * sizeof(VertexType));
+            }
+        }
     };
 }
 
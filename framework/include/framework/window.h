@@ -2,11 +2,70 @@
 #define PROG2002_WINDOW_H
 
 #include <string>
+#include <cstdint>
+#include <filesystem>
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
 namespace framework {
-    GLFWwindow *createWindow(int width, int height, const std::string &title);
+    /**
+     * How `createWindow` sets up the window and for how long it runs
+     */
+    struct WindowOptions {
+        /// Keep the window invisible and render into an offscreen framebuffer, for machines without a display
+        bool headless = false;
+
+        /// Close the window after this many frames have been swapped, 0 runs until it is closed
+        uint32_t frames = 0;
+
+        /// Record trace events and write them to this file on exit or when pressing F12, not traced if empty
+        std::filesystem::path tracePath;
+    };
+
+    /**
+     * Options given with `--headless <frames>`, `--frames <frames>` and `--trace <path>`. Without arguments,
+     * `PROG2002_HEADLESS=<frames>` and `PROG2002_TRACE=<path>` in the environment do the same, so programs that take
+     * no arguments can run on CI too. Exits with a usage error if a frame count is not a whole number or a value is
+     * missing.
+     */
+    WindowOptions windowOptions(int argc = 0, char *argv[] = nullptr);
+
+    /**
+     * Create a window with an OpenGL 4.5 core context and make it current. Throws if there is no context to create.
+     *
+     * A headless window is never shown. Instead of its default framebuffer, an offscreen framebuffer of the same size
+     * is bound for the lifetime of the window, so draws never touch pixels that the window system does not own.
+     */
+    GLFWwindow *createWindow(
+        int width,
+        int height,
+        const std::string &title,
+        const WindowOptions &options = windowOptions()
+    );
+
+    /**
+     * Present the frame, use instead of `glfwSwapBuffers`. Headless windows only flush, since there is nothing to
+     * present. Closes the window once the frame count of its options has been reached, and writes the trace when F12
+     * is pressed while tracing.
+     */
+    void swapBuffers(GLFWwindow *window);
+
+    /**
+     * Delete the offscreen framebuffer of a headless window, destroy the window and terminate GLFW. Use instead of
+     * `glfwTerminate` for windows made by `createWindow`.
+     */
+    void destroyWindow(GLFWwindow *window);
+
+    /**
+     * Whether the window created by `createWindow` is headless
+     */
+    bool isHeadless();
+
+    /**
+     * Create an invisible window whose context shares objects with the context of `window`, so another thread can
+     * create textures and buffers for it. Has to be called from the main thread.
+     */
+    GLFWwindow *createSharedContext(GLFWwindow *window);
 }
 
 #endif //PROG2002_WINDOW_H
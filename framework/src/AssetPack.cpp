@@ -0,0 +1,204 @@
+#include "framework/AssetPack.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Identifies the file type, ends with a version number
+static const char PACK_IDENTIFIER[8] = {'P', 'R', 'O', 'G', 'P', 'A', 'K', '1'};
+
+struct PackHeader {
+    char identifier[8];
+    uint64_t entriesAmount;
+};
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + framework::ASSET_PACK_ALIGNMENT - 1) / framework::ASSET_PACK_ALIGNMENT
+           * framework::ASSET_PACK_ALIGNMENT;
+}
+
+namespace framework {
+    AssetPack::AssetPack(const std::string &path) {
+#ifdef _WIN32
+        fileHandle = CreateFileA(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+        );
+        if (fileHandle == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open asset pack " + path);
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            unmap();
+            throw std::runtime_error("Failed to read the size of asset pack " + path);
+        }
+        size = (size_t) fileSize.QuadPart;
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle != nullptr) {
+            data = static_cast<const std::byte *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+
+        if (data == nullptr) {
+            unmap();
+            throw std::runtime_error("Failed to map asset pack " + path);
+        }
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file == -1) throw std::runtime_error("Failed to open asset pack " + path);
+
+        struct stat fileStatus = {};
+        if (fstat(file, &fileStatus) == -1) {
+            close(file);
+            throw std::runtime_error("Failed to read the size of asset pack " + path);
+        }
+        size = (size_t) fileStatus.st_size;
+
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping stays valid without the file descriptor
+        close(file);
+
+        if (mapping == MAP_FAILED) throw std::runtime_error("Failed to map asset pack " + path);
+        data = static_cast<const std::byte *>(mapping);
+#endif
+
+        try {
+            readIndex(path);
+        } catch (...) {
+            // The destructor does not run for a throwing constructor
+            unmap();
+            throw;
+        }
+    }
+
+    void AssetPack::readIndex(const std::string &path) {
+        PackHeader header;
+        if (size < sizeof(header)) throw std::runtime_error("Truncated asset pack " + path);
+        std::memcpy(&header, data, sizeof(header));
+
+        if (std::memcmp(header.identifier, PACK_IDENTIFIER, sizeof(PACK_IDENTIFIER)) != 0) {
+            throw std::runtime_error("Not an asset pack: " + path);
+        }
+
+        // Divided rather than multiplied, so a corrupt amount can not overflow past the check
+        auto entries = reinterpret_cast<const AssetPackEntry *>(data + sizeof(header));
+        if (header.entriesAmount > (size - sizeof(header)) / sizeof(AssetPackEntry)) {
+            throw std::runtime_error("Truncated asset pack " + path);
+        }
+
+        for (uint64_t entryIndex = 0; entryIndex < header.entriesAmount; ++entryIndex) {
+            auto &entry = entries[entryIndex];
+            bool isAssetInside = entry.offset <= size && entry.size <= size - entry.offset;
+            bool isNameInside = entry.nameOffset <= size && entry.nameSize <= size - entry.nameOffset;
+            if (!isAssetInside || !isNameInside) {
+                throw std::runtime_error("Corrupt asset pack " + path);
+            }
+
+            auto name = std::string_view(reinterpret_cast<const char *>(data + entry.nameOffset), entry.nameSize);
+            assets[name] = {data + entry.offset, entry.size};
+        }
+    }
+
+    AssetPack::AssetPack(AssetPack &&assetPack) noexcept:
+        data(assetPack.data),
+        size(assetPack.size),
+#ifdef _WIN32
+        fileHandle(assetPack.fileHandle),
+        mappingHandle(assetPack.mappingHandle),
+#endif
+        assets(std::move(assetPack.assets)) {
+        assetPack.data = nullptr;
+#ifdef _WIN32
+        assetPack.fileHandle = nullptr;
+        assetPack.mappingHandle = nullptr;
+#endif
+    }
+
+    AssetPack::~AssetPack() {
+        unmap();
+    }
+
+    void AssetPack::unmap() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle && fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#else
+        if (data) munmap(const_cast<std::byte *>(data), size);
+#endif
+    }
+
+    std::span<const std::byte> AssetPack::asset(std::string_view name) const {
+        auto asset = assets.find(name);
+        if (asset == assets.end()) throw std::runtime_error("Asset pack has no " + std::string(name));
+
+        return asset->second;
+    }
+
+    std::string_view AssetPack::text(std::string_view name) const {
+        auto contents = asset(name);
+
+        return {reinterpret_cast<const char *>(contents.data()), contents.size()};
+    }
+
+    bool AssetPack::contains(std::string_view name) const {
+        return assets.contains(name);
+    }
+
+    void writeAssetPack(const std::string &path, const std::vector<PackedFile> &files) {
+        PackHeader header = {.entriesAmount = files.size()};
+        std::memcpy(header.identifier, PACK_IDENTIFIER, sizeof(PACK_IDENTIFIER));
+
+        // Names follow the index, assets follow the names
+        std::vector<AssetPackEntry> entries;
+        uint64_t nameOffset = sizeof(header) + files.size() * sizeof(AssetPackEntry);
+        for (auto &file: files) {
+            entries.push_back({.nameOffset = nameOffset, .nameSize = file.name.size()});
+            nameOffset += file.name.size();
+        }
+
+        std::vector<std::vector<char>> contents;
+        uint64_t offset = nameOffset;
+        for (size_t fileIndex = 0; fileIndex < files.size(); ++fileIndex) {
+            std::ifstream input(files[fileIndex].path, std::ios::binary);
+            if (!input) throw std::runtime_error("Failed to open " + files[fileIndex].path);
+
+            contents.emplace_back(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+            offset = alignUp(offset);
+            entries[fileIndex].offset = offset;
+            entries[fileIndex].size = contents.back().size();
+            offset += contents.back().size();
+        }
+
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(
+            reinterpret_cast<const char *>(entries.data()),
+            (std::streamsize) (entries.size() * sizeof(AssetPackEntry))
+        );
+
+        for (auto &file: files) {
+            output.write(file.name.data(), (std::streamsize) file.name.size());
+        }
+
+        for (size_t fileIndex = 0; fileIndex < files.size(); ++fileIndex) {
+            // Pad up to the aligned offset
+            std::vector<char> padding(entries[fileIndex].offset - (uint64_t) output.tellp(), 0);
+            output.write(padding.data(), (std::streamsize) padding.size());
+            output.write(contents[fileIndex].data(), (std::streamsize) contents[fileIndex].size());
+        }
+
+        if (!output) throw std::runtime_error("Failed to write " + path);
+    }
+}
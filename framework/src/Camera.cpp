@@ -45,10 +45,41 @@ namespace framework {
 
 
     glm::mat4 Camera::viewMatrix() const {
-        return glm::lookAt(
+        updateMatrixCache();
+
+        return matrixCache.viewMatrix;
+    }
+
+    glm::mat4 Camera::viewProjectionMatrix() const {
+        updateMatrixCache();
+
+        return matrixCache.viewProjectionMatrix;
+    }
+
+    void Camera::updateMatrixCache() const {
+        bool isUpToDate =
+            matrixCache.isValid &&
+            matrixCache.position == position &&
+            matrixCache.target == target &&
+            matrixCache.up == up &&
+            matrixCache.projectionMatrix == projectionMatrix;
+
+        if (isUpToDate) return;
+
+        auto viewMatrix = glm::lookAt(
             position,
             target,
             up
         );
+
+        matrixCache = {
+            .projectionMatrix = projectionMatrix,
+            .position = position,
+            .target = target,
+            .up = up,
+            .viewMatrix = viewMatrix,
+            .viewProjectionMatrix = projectionMatrix * viewMatrix,
+            .isValid = true
+        };
     }
-}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include <algorithm>
+#include "framework/DirtyRanges.h"
+
+namespace framework {
+    void DirtyRanges::mark(uint32_t begin, uint32_t end) {
+        if (begin >= end) return;
+
+        // Extend the last range when marking elements in order, which is the common case
+        if (!ranges.empty() && ranges.back().begin <= begin && begin <= ranges.back().end) {
+            ranges.back().end = std::max(ranges.back().end, end);
+            return;
+        }
+
+        ranges.push_back({.begin = begin, .end = end});
+    }
+
+    bool DirtyRanges::empty() const {
+        return ranges.empty();
+    }
+
+    std::vector<DirtyRanges::Range> DirtyRanges::take() {
+        std::ranges::sort(ranges, {}, &Range::begin);
+
+        std::vector<Range> coalesced;
+        for (auto range: ranges) {
+            if (!coalesced.empty() && range.begin <= coalesced.back().end) {
+                coalesced.back().end = std::max(coalesced.back().end, range.end);
+            } else {
+                coalesced.push_back(range);
+            }
+        }
+
+        ranges.clear();
+
+        return coalesced;
+    }
+}
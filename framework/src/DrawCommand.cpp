@@ -0,0 +1,120 @@
+#include "framework/DrawCommand.h"
+#include "framework/FrameStats.h"
+#include "framework/GpuProfiler.h"
+#include "framework/Trace.h"
+
+namespace framework {
+    DrawCommand &DrawCommand::withUniform(const std::string &name, UniformValue value) {
+        uniforms.push_back({.location = shader->uniformLocation(name), .value = value});
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withTexture(uint32_t unit, uint32_t textureId) {
+        textures.push_back({.unit = unit, .textureId = textureId});
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withTexture(uint32_t unit, const Texture &texture) {
+        return withTexture(unit, texture.textureId());
+    }
+
+    DrawCommand &DrawCommand::withTexture(uint32_t unit, const Texture &texture, const Sampler &sampler) {
+        textures.push_back({.unit = unit, .textureId = texture.textureId(), .samplerId = sampler.samplerId()});
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withUniformBuffer(uint32_t slot, BufferRange range) {
+        uniformBuffers.push_back({.slot = slot, .range = range});
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withShaderStorageBuffer(uint32_t slot, BufferRange range) {
+        shaderStorageBuffers.push_back({.slot = slot, .range = range});
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withPolygonMode(GLenum mode) {
+        polygonMode = mode;
+
+        return *this;
+    }
+
+    DrawCommand &DrawCommand::withLabel(std::string name) {
+        label = std::move(name);
+
+        return *this;
+    }
+
+    uint32_t DrawCommand::primaryTextureId() const {
+        const TextureBinding *primary = nullptr;
+
+        for (auto &texture: textures) {
+            if (!primary || texture.unit < primary->unit) primary = &texture;
+        }
+
+        return primary ? primary->textureId : 0;
+    }
+
+    void DrawCommand::issue() const {
+        PROG2002_TRACE_SCOPE("DrawCommand::issue");
+
+        std::optional<GpuProfiler::Scope> scope;
+        if (!label.empty() && gpuProfiler().isEnabled()) scope.emplace(gpuProfiler(), label);
+
+        auto &state = renderState();
+
+        state.useProgram(shader->id);
+        state.bindVertexArray(vertexArrayId);
+        if (polygonMode.has_value()) state.setPolygonMode(*polygonMode);
+
+        for (auto [unit, textureId, samplerId]: textures) {
+            state.bindTextureUnit(unit, textureId);
+
+            // Also unbinds samplers of earlier draws from units whose texture uses its own parameters
+            state.bindSampler(unit, samplerId);
+        }
+
+        for (auto [slot, range]: uniformBuffers) {
+            state.bindUniformBuffer(slot, range);
+        }
+
+        for (auto [slot, range]: shaderStorageBuffers) {
+            state.bindShaderStorageBuffer(slot, range);
+        }
+
+        for (auto &[location, value]: uniforms) {
+            std::visit([this, location](auto uniformValue) {
+                using ValueType = decltype(uniformValue);
+
+                if constexpr (std::is_same_v<ValueType, bool>) shader->uploadUniformBool1(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, int>) shader->uploadUniformInt1(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, glm::ivec2>) shader->uploadUniformInt2(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, float>) shader->uploadUniformFloat1(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, glm::vec3>) shader->uploadUniformFloat3(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, glm::vec4>) shader->uploadUniformFloat4(location, uniformValue);
+                else if constexpr (std::is_same_v<ValueType, glm::mat4>) shader->uploadUniformMatrix4(location, uniformValue);
+            }, value);
+        }
+
+        countDrawCall();
+
+        if (isIndexed) {
+            if (instances == 1) {
+                glDrawElements(drawMode, (int32_t) elementsAmount, GL_UNSIGNED_INT, nullptr);
+            } else {
+                glDrawElementsInstanced(drawMode, (int32_t) elementsAmount, GL_UNSIGNED_INT, nullptr, (int32_t) instances);
+            }
+        } else {
+            if (instances == 1) {
+                glDrawArrays(drawMode, 0, (int32_t) elementsAmount);
+            } else {
+                glDrawArraysInstanced(drawMode, 0, (int32_t) elementsAmount, (int32_t) instances);
+            }
+        }
+    }
+}
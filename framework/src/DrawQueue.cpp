@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <bit>
+#include "framework/DrawQueue.h"
+#include "framework/Trace.h"
+#include "glm/glm.hpp"
+
+/**
+ * Quantize a non-negative depth to 24 bits, keeping the order of values.
+ * The bit pattern of a positive float grows with its value, so its top bits can be used directly.
+ */
+static uint64_t quantizeDepth(float depth) {
+    depth = std::max(depth, 0.f);
+
+    return std::bit_cast<uint32_t>(depth) >> 7;
+}
+
+namespace framework {
+    void DrawQueue::setCameraPosition(glm::vec3 position) {
+        cameraPosition = position;
+    }
+
+    void DrawQueue::submit(DrawCommand command, RenderPass pass, glm::vec3 center) {
+        float depth = glm::length(center - cameraPosition);
+        auto key = sortKey(pass, command.shader->id, command.primaryTextureId(), depth);
+
+        // Queued draws can run in any order, so they must not inherit the polygon mode of another draw
+        if (!command.polygonMode.has_value()) command.polygonMode = GL_FILL;
+
+        entries.push_back({.key = key, .commandIndex = (uint32_t) commands.size()});
+        commands.push_back(std::move(command));
+    }
+
+    void DrawQueue::flush() {
+        PROG2002_TRACE_SCOPE("DrawQueue::flush");
+
+        // Stable, so draws with equal keys keep the order they were submitted in
+        std::ranges::stable_sort(entries, {}, &Entry::key);
+
+        for (auto entry: entries) {
+            commands[entry.commandIndex].issue();
+        }
+
+        entries.clear();
+        commands.clear();
+    }
+
+    uint64_t DrawQueue::sortKey(RenderPass pass, uint32_t shaderId, uint32_t textureId, float depth) {
+        uint64_t passBits = (uint64_t) pass & 0x3;
+        uint64_t shaderBits = shaderId & 0xFFFF;
+        uint64_t textureBits = textureId & 0xFFFF;
+        uint64_t depthBits = quantizeDepth(depth) & 0xFFFFFF;
+
+        if (pass == RenderPass::Transparent) {
+            uint64_t invertedDepthBits = 0xFFFFFF - depthBits;
+
+            return (passBits << 62) | (invertedDepthBits << 38) | (shaderBits << 22) | (textureBits << 6);
+        }
+
+        return (passBits << 62) | (shaderBits << 46) | (textureBits << 30) | (depthBits << 6);
+    }
+}
@@ -0,0 +1,53 @@
+#include <stdexcept>
+#include "framework/FrameStats.h"
+
+static framework::FrameStats currentFrameStats;
+static framework::FrameStats lastFrameStats;
+
+namespace framework {
+    FrameStats &frameStats() {
+        return currentFrameStats;
+    }
+
+    const FrameStats &previousFrameStats() {
+        return lastFrameStats;
+    }
+
+    std::ostream &operator<<(std::ostream &output, const FrameStats &frameStats) {
+        return output
+            << "Draw calls: " << frameStats.drawCalls
+            << ", uniform uploads: " << frameStats.uniformUploads
+            << ", buffer uploads: " << frameStats.bufferUploads
+            << " (" << frameStats.bufferBytesUploaded << " bytes)"
+            << ", buffers created: " << frameStats.buffersCreated
+            << ", textures loaded: " << frameStats.texturesLoaded
+            << " (" << frameStats.textureBytesLoaded << " bytes)"
+            << ", state changes issued: " << frameStats.stateChangesIssued
+            << ", skipped: " << frameStats.stateChangesSkipped;
+    }
+
+    FrameStatsCsv::FrameStatsCsv(const std::filesystem::path &path) : file(path) {
+        if (!file) throw std::runtime_error("Failed to create " + path.string());
+
+        file << "frame,draw_calls,uniform_uploads,buffer_uploads,buffer_bytes_uploaded,buffers_created,"
+             << "textures_loaded,texture_bytes_loaded,state_changes_issued,state_changes_skipped\n";
+    }
+
+    void FrameStatsCsv::write(const FrameStats &frameStats) {
+        file << frame++ << ','
+             << frameStats.drawCalls << ','
+             << frameStats.uniformUploads << ','
+             << frameStats.bufferUploads << ','
+             << frameStats.bufferBytesUploaded << ','
+             << frameStats.buffersCreated << ','
+             << frameStats.texturesLoaded << ','
+             << frameStats.textureBytesLoaded << ','
+             << frameStats.stateChangesIssued << ','
+             << frameStats.stateChangesSkipped << '\n';
+    }
+
+    void endFrameStats() {
+        lastFrameStats = currentFrameStats;
+        currentFrameStats = {};
+    }
+}
@@ -0,0 +1,161 @@
+#include <cstddef>
+#include <sstream>
+#include <vector>
+#include "stb_easy_font.h"
+#include "framework/FrameStatsOverlay.h"
+#include "framework/RenderState.h"
+
+// language=glsl
+static const std::string vertexShaderSource = R"(
+    #version 450 core
+
+    layout(location = 0) in vec3 position;
+    layout(location = 1) in vec4 color;
+
+    uniform ivec2 screen_size;
+    uniform float scale;
+
+    out vec4 vertex_color;
+
+    void main() {
+        vec2 pixel = position.xy * scale / vec2(screen_size);
+
+        gl_Position = vec4(pixel.x * 2. - 1., 1. - pixel.y * 2., 0., 1.);
+        vertex_color = color;
+    }
+)";
+
+// language=glsl
+static const std::string fragmentShaderSource = R"(
+    #version 450 core
+
+    in vec4 vertex_color;
+
+    out vec4 color;
+
+    void main() {
+        color = vertex_color;
+    }
+)";
+
+/// Space around the text covered by the background, in glyph pixels
+static const float PADDING = 3.f;
+
+namespace framework {
+    FrameStatsOverlay::FrameStatsOverlay() : shader(vertexShaderSource, fragmentShaderSource) {
+        glCreateBuffers(1, &vertexBufferId);
+        glCreateBuffers(1, &indexBufferId);
+
+        glCreateVertexArrays(1, &vertexArrayId);
+        glVertexArrayVertexBuffer(vertexArrayId, 0, vertexBufferId, 0, sizeof(Vertex));
+        glVertexArrayElementBuffer(vertexArrayId, indexBufferId);
+
+        glEnableVertexArrayAttrib(vertexArrayId, 0);
+        glVertexArrayAttribBinding(vertexArrayId, 0, 0);
+        glVertexArrayAttribFormat(vertexArrayId, 0, 3, GL_FLOAT, false, offsetof(Vertex, x));
+
+        glEnableVertexArrayAttrib(vertexArrayId, 1);
+        glVertexArrayAttribBinding(vertexArrayId, 1, 0);
+        glVertexArrayAttribFormat(vertexArrayId, 1, 4, GL_UNSIGNED_BYTE, true, offsetof(Vertex, color));
+    }
+
+    FrameStatsOverlay::FrameStatsOverlay(FrameStatsOverlay &&overlay) noexcept:
+        shader(std::move(overlay.shader)),
+        vertexArrayId(overlay.vertexArrayId),
+        vertexBufferId(overlay.vertexBufferId),
+        indexBufferId(overlay.indexBufferId),
+        quadsCapacity(overlay.quadsCapacity) {
+        overlay.vertexArrayId = 0;
+        overlay.vertexBufferId = 0;
+        overlay.indexBufferId = 0;
+    }
+
+    FrameStatsOverlay::~FrameStatsOverlay() {
+        if (vertexArrayId) {
+            renderState().forgetVertexArray(vertexArrayId);
+            glDeleteVertexArrays(1, &vertexArrayId);
+        }
+        if (vertexBufferId) glDeleteBuffers(1, &vertexBufferId);
+        if (indexBufferId) glDeleteBuffers(1, &indexBufferId);
+    }
+
+    void FrameStatsOverlay::draw(const FrameStats &frameStats, int width, int height, glm::vec2 position, float scale) {
+        // Keep the overlay's own work out of the counters
+        auto countedStats = framework::frameStats();
+
+        auto content = text(frameStats);
+        auto origin = position / scale;
+
+        // Background behind the text first, the glyphs are drawn on top of it
+        float textWidth = (float) stb_easy_font_width(content.data());
+        float textHeight = (float) stb_easy_font_height(content.data());
+        float left = origin.x - PADDING;
+        float top = origin.y - PADDING;
+        float right = origin.x + textWidth + PADDING;
+        float bottom = origin.y + textHeight + PADDING;
+
+        std::vector<Vertex> vertices = {
+            {left, top, 0.f, {0, 0, 0, 255}},
+            {right, top, 0.f, {0, 0, 0, 255}},
+            {right, bottom, 0.f, {0, 0, 0, 255}},
+            {left, bottom, 0.f, {0, 0, 0, 255}},
+        };
+
+        // stb_easy_font needs about 200 bytes per character, and stops writing quads when the buffer is full
+        vertices.resize(4 + content.size() * 270 / sizeof(Vertex));
+        auto glyphQuads = stb_easy_font_print(
+            origin.x,
+            origin.y,
+            content.data(),
+            nullptr,
+            vertices.data() + 4,
+            (int) ((vertices.size() - 4) * sizeof(Vertex))
+        );
+
+        auto quads = (uint32_t) glyphQuads + 1;
+        glNamedBufferData(vertexBufferId, quads * 4 * sizeof(Vertex), vertices.data(), GL_STREAM_DRAW);
+
+        if (quads > quadsCapacity) {
+            // Two triangles per quad, the text decides how many quads there are
+            quadsCapacity = quads * 2;
+
+            std::vector<uint32_t> indices;
+            for (uint32_t quad = 0; quad < quadsCapacity; ++quad) {
+                for (uint32_t corner: {0, 1, 2, 0, 2, 3}) indices.push_back(quad * 4 + corner);
+            }
+            glNamedBufferData(indexBufferId, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+        }
+
+        // Glyphs overlap the background, so draw in order without the depth test. Asked from OpenGL instead of the
+        // shadow state, which may not know whether it is on.
+        auto wasDepthTested = (bool) glIsEnabled(GL_DEPTH_TEST);
+
+        auto &state = renderState();
+        state.useProgram(shader.id);
+        state.bindVertexArray(vertexArrayId);
+        state.setPolygonMode(GL_FILL);
+        state.setDepthTest(false);
+
+        shader.uploadUniformInt2("screen_size", {width, height});
+        shader.uploadUniformFloat1("scale", scale);
+
+        glDrawElements(GL_TRIANGLES, (int32_t) quads * 6, GL_UNSIGNED_INT, nullptr);
+
+        state.setDepthTest(wasDepthTested);
+        framework::frameStats() = countedStats;
+    }
+
+    std::string FrameStatsOverlay::text(const FrameStats &frameStats) {
+        std::ostringstream text;
+
+        text << "Draw calls:      " << frameStats.drawCalls << "\n"
+             << "Uniform uploads: " << frameStats.uniformUploads << "\n"
+             << "Buffer uploads:  " << frameStats.bufferUploads << " (" << frameStats.bufferBytesUploaded << " B)\n"
+             << "Buffers created: " << frameStats.buffersCreated << "\n"
+             << "Textures loaded: " << frameStats.texturesLoaded << " (" << frameStats.textureBytesLoaded << " B)\n"
+             << "State changes:   " << frameStats.stateChangesIssued
+             << " (" << frameStats.stateChangesSkipped << " skipped)";
+
+        return text.str();
+    }
+}
@@ -0,0 +1,25 @@
+#include "framework/FrameUniforms.h"
+
+namespace framework {
+    FrameUniformBuffer FrameUniformBuffer::create() {
+        auto uniformBuffer = StreamingUniformBuffer<FrameUniforms>::create({FrameUniforms{}});
+
+        return {
+            .uniformBuffer = std::move(uniformBuffer)
+        };
+    }
+
+    void FrameUniformBuffer::update(const Camera &camera, float time) {
+        FrameUniforms frameUniforms = {
+            .view = camera.viewMatrix(),
+            .projection = camera.projectionMatrix,
+            .viewProjection = camera.viewProjectionMatrix(),
+            .cameraPosition = camera.position,
+            .time = time
+        };
+
+        uniformBuffer.setElements(0, {&frameUniforms, 1});
+        uniformBuffer.commit();
+        uniformBuffer.bind(FRAME_UNIFORMS_BINDING);
+    }
+}
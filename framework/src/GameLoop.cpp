@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "framework/GameLoop.h"
+
+/**
+ * Frames per second given after `--fps`, exits with a usage error unless it is a positive number
+ */
+static double parseFrameRate(const char *value) {
+    char *end = nullptr;
+    double frameRate = value != nullptr ? std::strtod(value, &end) : 0.;
+
+    if (value == nullptr || end == value || *end != '\0' || !std::isfinite(frameRate) || frameRate <= 0.) {
+        std::cerr << "Usage: --fps <frames per second>, got " << (value != nullptr ? value : "nothing") << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return frameRate;
+}
+
+namespace framework {
+    GameLoopSettings gameLoopSettings(int argc, char *argv[]) {
+        GameLoopSettings settings;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+
+            if (argument == "--uncapped") {
+                settings.pacing = FramePacing::Uncapped;
+            } else if (argument == "--fps") {
+                settings.pacing = FramePacing::Capped;
+                settings.frameRateCap = parseFrameRate(i + 1 < argc ? argv[++i] : nullptr);
+            }
+        }
+
+        return settings;
+    }
+
+    GameLoop::GameLoop(GLFWwindow *window, GameLoopSettings settings) : window(window), settings(settings) {
+        setPacing(settings.pacing, settings.frameRateCap);
+
+        frameStartTime = glfwGetTime();
+        nextFrameTime = frameStartTime;
+    }
+
+    bool GameLoop::beginFrame() {
+        glfwPollEvents();
+        if (glfwWindowShouldClose(window)) return false;
+
+        auto time = glfwGetTime();
+        accumulatedTime += std::min(time - frameStartTime, settings.maxFrameTime);
+        frameStartTime = time;
+
+        return true;
+    }
+
+    bool GameLoop::step() {
+        if (accumulatedTime < settings.timeStep) return false;
+
+        accumulatedTime -= settings.timeStep;
+        simulatedTime += settings.timeStep;
+
+        return true;
+    }
+
+    float GameLoop::alpha() const {
+        return (float) (accumulatedTime / settings.timeStep);
+    }
+
+    double GameLoop::time() const {
+        return simulatedTime + accumulatedTime;
+    }
+
+    double GameLoop::timeStep() const {
+        return settings.timeStep;
+    }
+
+    double GameLoop::frameStart() const {
+        return frameStartTime;
+    }
+
+    void GameLoop::endFrame() {
+        finishedFrames++;
+        if (settings.pacing != FramePacing::Capped) return;
+
+        auto framePeriod = 1. / settings.frameRateCap;
+        nextFrameTime += framePeriod;
+
+        // Too far behind to catch up, start counting from now instead of rushing the missed frames
+        auto time = glfwGetTime();
+        if (time > nextFrameTime + framePeriod) nextFrameTime = time;
+
+        waitUntil(nextFrameTime);
+    }
+
+    void GameLoop::setPacing(FramePacing pacing, double frameRateCap) {
+        settings.pacing = pacing;
+        settings.frameRateCap = frameRateCap;
+
+        glfwSwapInterval(pacing == FramePacing::VSync ? 1 : 0);
+        nextFrameTime = glfwGetTime();
+    }
+
+    FramePacing GameLoop::pacing() const {
+        return settings.pacing;
+    }
+
+    uint64_t GameLoop::framesAmount() const {
+        return finishedFrames;
+    }
+
+    void GameLoop::waitUntil(double deadline) {
+        const double sleepSlice = 0.001;
+
+        while (deadline - glfwGetTime() > sleepEstimate) {
+            auto sleepStart = glfwGetTime();
+            std::this_thread::sleep_for(std::chrono::duration<double>(sleepSlice));
+            auto slept = glfwGetTime() - sleepStart;
+
+            // Follows the longest recent sleep, decaying slowly so one late wake-up does not make it spin for good
+            sleepEstimate = std::max(slept, sleepEstimate * 0.99 + sleepSlice * 0.01);
+        }
+
+        while (glfwGetTime() < deadline) {}
+    }
+}
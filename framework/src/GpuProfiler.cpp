@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include "framework/GpuProfiler.h"
+
+/**
+ * Minimum, average and 99th percentile of `values`
+ */
+static framework::GpuProfiler::Timing timing(std::vector<double> values) {
+    if (values.empty()) return {};
+
+    std::ranges::sort(values);
+
+    double sum = 0.;
+    for (auto value: values) sum += value;
+
+    auto p99Index = (size_t) std::ceil(0.99 * (double) values.size()) - 1;
+
+    return {
+        .min = values.front(),
+        .average = sum / (double) values.size(),
+        .p99 = values[p99Index]
+    };
+}
+
+namespace framework {
+    GpuProfiler::Scope::Scope(GpuProfiler &profiler, const std::string &name) : profiler(profiler) {
+        profiler.beginScope(name);
+    }
+
+    GpuProfiler::Scope::~Scope() {
+        profiler.endScope();
+    }
+
+    GpuProfiler::GpuProfiler(uint32_t historyFrames) : historyFrames(historyFrames) {}
+
+    GpuProfiler::~GpuProfiler() {
+        clear();
+    }
+
+    void GpuProfiler::enable() {
+        enabled = true;
+    }
+
+    bool GpuProfiler::isEnabled() const {
+        return enabled;
+    }
+
+    void GpuProfiler::beginFrame() {
+        if (!enabled) return;
+        assert(!isInFrame);
+
+        frameIndex = (frameIndex + 1) % FRAMES_IN_FLIGHT;
+
+        if (isTracing() && gpuTrack == nullptr) {
+            // Both clocks count nanoseconds, so one offset maps GPU timestamps onto the trace
+            int64_t gpuTime;
+            glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+            gpuClockOffset = (int64_t) traceTime() - gpuTime;
+
+            gpuTrack = &traceTrack("GPU");
+        }
+
+        auto &frame = frames[frameIndex];
+        if (frame.isPending) readBack(frame);
+
+        frame.queriesUsed = 0;
+        frame.samples.clear();
+
+        isInFrame = true;
+        beginScope("Frame");
+    }
+
+    void GpuProfiler::endFrame() {
+        if (!enabled) return;
+
+        endScope();
+        assert(openScopes.empty());
+
+        frames[frameIndex].isPending = true;
+        isInFrame = false;
+    }
+
+    void GpuProfiler::beginScope(const std::string &name) {
+        if (!isInFrame) return;
+
+        openScopes.push_back(
+            {
+                .scopeIndex = scopeIndex(name),
+                .beginQuery = issueTimestamp(),
+                .start = std::chrono::steady_clock::now()
+            }
+        );
+    }
+
+    void GpuProfiler::endScope() {
+        if (!isInFrame) return;
+        assert(!openScopes.empty());
+
+        auto scope = openScopes.back();
+        openScopes.pop_back();
+
+        auto end = std::chrono::steady_clock::now();
+
+        frames[frameIndex].samples.push_back(
+            {
+                .scopeIndex = scope.scopeIndex,
+                .beginQuery = scope.beginQuery,
+                .endQuery = issueTimestamp(),
+                .cpuMilliseconds = std::chrono::duration<double, std::milli>(end - scope.start).count()
+            }
+        );
+    }
+
+    std::vector<GpuProfiler::ScopeStats> GpuProfiler::stats() const {
+        std::vector<ScopeStats> scopeStats;
+
+        for (auto &history: histories) {
+            scopeStats.push_back(
+                {
+                    .name = history.name,
+                    .cpu = timing(history.cpu),
+                    .gpu = timing(history.gpu),
+                    .frames = (uint32_t) history.cpu.size()
+                }
+            );
+        }
+
+        return scopeStats;
+    }
+
+    uint32_t GpuProfiler::skippedFramesAmount() const {
+        return skippedFrames;
+    }
+
+    void GpuProfiler::writeCsv(std::ostream &output) const {
+        output << "scope,frames,cpu_min_ms,cpu_average_ms,cpu_p99_ms,gpu_min_ms,gpu_average_ms,gpu_p99_ms\n";
+
+        for (auto &scope: stats()) {
+            output << scope.name << ',' << scope.frames << ','
+                   << scope.cpu.min << ',' << scope.cpu.average << ',' << scope.cpu.p99 << ','
+                   << scope.gpu.min << ',' << scope.gpu.average << ',' << scope.gpu.p99 << '\n';
+        }
+    }
+
+    void GpuProfiler::clear() {
+        for (auto &frame: frames) {
+            if (!frame.queryIds.empty()) glDeleteQueries((int32_t) frame.queryIds.size(), frame.queryIds.data());
+
+            frame = {};
+        }
+    }
+
+    uint32_t GpuProfiler::scopeIndex(const std::string &name) {
+        auto [iterator, isNew] = scopeIndices.try_emplace(name, (uint32_t) histories.size());
+        if (isNew) histories.push_back({.name = name, .traceName = framework::traceName(name)});
+
+        return iterator->second;
+    }
+
+    uint32_t GpuProfiler::issueTimestamp() {
+        auto &frame = frames[frameIndex];
+
+        // Queries of a frame are kept for reuse, so the pool only grows until it fits the busiest frame
+        if (frame.queriesUsed == frame.queryIds.size()) {
+            uint32_t queryId;
+            glCreateQueries(GL_TIMESTAMP, 1, &queryId);
+            frame.queryIds.push_back(queryId);
+        }
+
+        auto query = frame.queriesUsed++;
+        glQueryCounter(frame.queryIds[query], GL_TIMESTAMP);
+
+        return query;
+    }
+
+    void GpuProfiler::readBack(FrameQueries &frame) {
+        frame.isPending = false;
+        if (frame.samples.empty()) return;
+
+        // Queries finish in the order they were issued, so every query is done once the last one is
+        int32_t isAvailable = 0;
+        glGetQueryObjectiv(frame.queryIds[frame.queriesUsed - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (!isAvailable) {
+            skippedFrames++;
+
+            return;
+        }
+
+        // Sum scopes that ran several times during the frame
+        std::vector<double> cpuTotals(histories.size(), 0.);
+        std::vector<double> gpuTotals(histories.size(), 0.);
+        std::vector<bool> hasRun(histories.size(), false);
+
+        for (auto &sample: frame.samples) {
+            uint64_t begin;
+            uint64_t end;
+            glGetQueryObjectui64v(frame.queryIds[sample.beginQuery], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.queryIds[sample.endQuery], GL_QUERY_RESULT, &end);
+
+            cpuTotals[sample.scopeIndex] += sample.cpuMilliseconds;
+            gpuTotals[sample.scopeIndex] += (double) (end - begin) / 1'000'000.;
+            hasRun[sample.scopeIndex] = true;
+
+            if (gpuTrack != nullptr) {
+                gpuTrack->record(
+                    {
+                        .name = histories[sample.scopeIndex].traceName,
+                        .start = (uint64_t) ((int64_t) begin + gpuClockOffset),
+                        .duration = end - begin
+                    }
+                );
+            }
+        }
+
+        for (size_t index = 0; index < histories.size(); ++index) {
+            if (!hasRun[index]) continue;
+
+            auto &history = histories[index];
+            if (history.cpu.size() < historyFrames) {
+                history.cpu.push_back(cpuTotals[index]);
+                history.gpu.push_back(gpuTotals[index]);
+            } else {
+                history.cpu[history.next] = cpuTotals[index];
+                history.gpu[history.next] = gpuTotals[index];
+            }
+            history.next = (history.next + 1) % historyFrames;
+        }
+    }
+
+    std::ostream &operator<<(std::ostream &output, const GpuProfiler &profiler) {
+        auto flags = output.flags();
+        output << std::fixed << std::setprecision(3);
+
+        output << "Scope timings in ms (min / average / p99):";
+        for (auto &scope: profiler.stats()) {
+            output << "\n" << scope.name
+                   << ": CPU " << scope.cpu.min << " / " << scope.cpu.average << " / " << scope.cpu.p99
+                   << ", GPU " << scope.gpu.min << " / " << scope.gpu.average << " / " << scope.gpu.p99
+                   << " over " << scope.frames << " frames";
+        }
+
+        if (profiler.skippedFramesAmount() > 0) {
+            output << "\n" << profiler.skippedFramesAmount() << " frames skipped, the GPU was too far behind";
+        }
+
+        output.flags(flags);
+
+        return output;
+    }
+
+    GpuProfiler &gpuProfiler() {
+        static GpuProfiler gpuProfiler;
+
+        return gpuProfiler;
+    }
+}
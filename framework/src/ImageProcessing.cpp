@@ -0,0 +1,370 @@
+#include "framework/ImageProcessing.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PROG2002_X86_64
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+// MSVC allows every intrinsic without enabling the instruction set for the whole file
+#define TARGET(features)
+#else
+#define TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+
+/**
+ * @return Linear value of every sRGB encoded value, rounded to 8 bits
+ */
+static const std::array<uint8_t, 256> &srgbToLinearTable() {
+    static std::array<uint8_t, 256> table = []() {
+        std::array<uint8_t, 256> table = {};
+
+        for (int value = 0; value < 256; ++value) {
+            auto encoded = (float) value / 255.f;
+            auto linear = encoded <= 0.04045f
+                          ? encoded / 12.92f
+                          : std::pow((encoded + 0.055f) / 1.055f, 2.4f);
+
+            table[value] = (uint8_t) std::lround(linear * 255.f);
+        }
+
+        return table;
+    }();
+
+    return table;
+}
+
+/**
+ * `value * alpha / 255`, rounded to nearest without a division
+ */
+static uint8_t multiplyAlpha(uint8_t value, uint8_t alpha) {
+    uint32_t product = value * alpha + 128;
+
+    return (uint8_t) ((product + (product >> 8)) >> 8);
+}
+
+static void expandRgbToRgbaScalar(const uint8_t *rgb, uint8_t *rgba, size_t begin, size_t end) {
+    for (size_t pixel = begin; pixel < end; ++pixel) {
+        rgba[pixel * 4] = rgb[pixel * 3];
+        rgba[pixel * 4 + 1] = rgb[pixel * 3 + 1];
+        rgba[pixel * 4 + 2] = rgb[pixel * 3 + 2];
+        rgba[pixel * 4 + 3] = 255;
+    }
+}
+
+static void premultiplyAlphaScalar(uint8_t *rgba, size_t begin, size_t end) {
+    for (size_t pixel = begin; pixel < end; ++pixel) {
+        auto color = rgba + pixel * 4;
+
+        color[0] = multiplyAlpha(color[0], color[3]);
+        color[1] = multiplyAlpha(color[1], color[3]);
+        color[2] = multiplyAlpha(color[2], color[3]);
+    }
+}
+
+static void srgbToLinearScalar(uint8_t *rgba, size_t begin, size_t end) {
+    auto &table = srgbToLinearTable();
+
+    for (size_t pixel = begin; pixel < end; ++pixel) {
+        auto color = rgba + pixel * 4;
+
+        color[0] = table[color[0]];
+        color[1] = table[color[1]];
+        color[2] = table[color[2]];
+    }
+}
+
+static void swapRowsScalar(uint8_t *top, uint8_t *bottom, size_t begin, size_t end) {
+    std::swap_ranges(top + begin, top + end, bottom + begin);
+}
+
+#ifdef PROG2002_X86_64
+
+/// Moves the 3 bytes of every pixel to the start of its 4 bytes, leaving the alpha byte zero
+#define RGB_TO_RGBA_SHUFFLE 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128
+
+TARGET("ssse3")
+static size_t expandRgbToRgbaSsse3(const uint8_t *rgb, uint8_t *rgba, size_t pixelsAmount) {
+    auto shuffle = _mm_setr_epi8(RGB_TO_RGBA_SHUFFLE);
+    auto alpha = _mm_set1_epi32((int32_t) 0xFF000000);
+
+    // Reads 16 bytes for the 12 bytes of 4 pixels, so stops while 16 bytes are left
+    size_t pixel = 0;
+    for (; pixel + 6 <= pixelsAmount; pixel += 4) {
+        auto source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + pixel * 3));
+        auto expanded = _mm_or_si128(_mm_shuffle_epi8(source, shuffle), alpha);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + pixel * 4), expanded);
+    }
+
+    return pixel;
+}
+
+TARGET("avx2")
+static size_t expandRgbToRgbaAvx2(const uint8_t *rgb, uint8_t *rgba, size_t pixelsAmount) {
+    auto shuffle = _mm256_setr_epi8(RGB_TO_RGBA_SHUFFLE, RGB_TO_RGBA_SHUFFLE);
+    auto alpha = _mm256_set1_epi32((int32_t) 0xFF000000);
+
+    // Each 128-bit lane gets 4 pixels, as shuffles do not cross lanes
+    size_t pixel = 0;
+    for (; pixel + 10 <= pixelsAmount; pixel += 8) {
+        auto low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + pixel * 3));
+        auto high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + pixel * 3 + 12));
+        auto source = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        auto expanded = _mm256_or_si256(_mm256_shuffle_epi8(source, shuffle), alpha);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(rgba + pixel * 4), expanded);
+    }
+
+    return pixel;
+}
+
+/**
+ * Premultiply 2 pixels widened to 16 bits per channel, alpha stays as is by being multiplied with 255
+ */
+TARGET("sse2")
+static __m128i premultiplyWidenedSse2(__m128i pixels) {
+    auto alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    auto alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+
+    auto product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+
+    return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+TARGET("sse2")
+static size_t premultiplyAlphaSse2(uint8_t *rgba, size_t pixelsAmount) {
+    auto zero = _mm_setzero_si128();
+
+    size_t pixel = 0;
+    for (; pixel + 4 <= pixelsAmount; pixel += 4) {
+        auto address = reinterpret_cast<__m128i *>(rgba + pixel * 4);
+        auto pixels = _mm_loadu_si128(address);
+
+        auto low = premultiplyWidenedSse2(_mm_unpacklo_epi8(pixels, zero));
+        auto high = premultiplyWidenedSse2(_mm_unpackhi_epi8(pixels, zero));
+
+        _mm_storeu_si128(address, _mm_packus_epi16(low, high));
+    }
+
+    return pixel;
+}
+
+TARGET("avx2")
+static __m256i premultiplyWidenedAvx2(__m256i pixels) {
+    auto alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+    auto alpha = _mm256_shufflehi_epi16(
+        _mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+        _MM_SHUFFLE(3, 3, 3, 3)
+    );
+    alpha = _mm256_blendv_epi8(alpha, _mm256_set1_epi16(255), alphaLanes);
+
+    auto product = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), _mm256_set1_epi16(128));
+
+    return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+}
+
+TARGET("avx2")
+static size_t premultiplyAlphaAvx2(uint8_t *rgba, size_t pixelsAmount) {
+    auto zero = _mm256_setzero_si256();
+
+    // Unpacking and packing both work per 128-bit lane, so the pixel order is kept
+    size_t pixel = 0;
+    for (; pixel + 8 <= pixelsAmount; pixel += 8) {
+        auto address = reinterpret_cast<__m256i *>(rgba + pixel * 4);
+        auto pixels = _mm256_loadu_si256(address);
+
+        auto low = premultiplyWidenedAvx2(_mm256_unpacklo_epi8(pixels, zero));
+        auto high = premultiplyWidenedAvx2(_mm256_unpackhi_epi8(pixels, zero));
+
+        _mm256_storeu_si256(address, _mm256_packus_epi16(low, high));
+    }
+
+    return pixel;
+}
+
+TARGET("avx2")
+static size_t srgbToLinearAvx2(uint8_t *rgba, size_t pixelsAmount) {
+    // Widened to 32 bits for gathering
+    std::array<int32_t, 256> table = {};
+    std::copy(srgbToLinearTable().begin(), srgbToLinearTable().end(), table.begin());
+
+    auto byteMask = _mm256_set1_epi32(0xFF);
+    auto alphaBytes = _mm256_set1_epi32((int32_t) 0xFF000000);
+
+    // One gather per channel of 8 pixels, alpha is kept from the source
+    size_t pixel = 0;
+    for (; pixel + 8 <= pixelsAmount; pixel += 8) {
+        auto address = reinterpret_cast<__m256i *>(rgba + pixel * 4);
+        auto pixels = _mm256_loadu_si256(address);
+
+        auto red = _mm256_i32gather_epi32(table.data(), _mm256_and_si256(pixels, byteMask), 4);
+        auto green = _mm256_i32gather_epi32(
+            table.data(),
+            _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask),
+            4
+        );
+        auto blue = _mm256_i32gather_epi32(
+            table.data(),
+            _mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask),
+            4
+        );
+
+        auto linear = _mm256_or_si256(
+            _mm256_or_si256(red, _mm256_slli_epi32(green, 8)),
+            _mm256_or_si256(_mm256_slli_epi32(blue, 16), _mm256_and_si256(pixels, alphaBytes))
+        );
+        _mm256_storeu_si256(address, linear);
+    }
+
+    return pixel;
+}
+
+TARGET("sse2")
+static size_t swapRowsSse2(uint8_t *top, uint8_t *bottom, size_t rowBytes) {
+    size_t byte = 0;
+    for (; byte + 16 <= rowBytes; byte += 16) {
+        auto topAddress = reinterpret_cast<__m128i *>(top + byte);
+        auto bottomAddress = reinterpret_cast<__m128i *>(bottom + byte);
+
+        auto topBytes = _mm_loadu_si128(topAddress);
+        _mm_storeu_si128(topAddress, _mm_loadu_si128(bottomAddress));
+        _mm_storeu_si128(bottomAddress, topBytes);
+    }
+
+    return byte;
+}
+
+TARGET("avx2")
+static size_t swapRowsAvx2(uint8_t *top, uint8_t *bottom, size_t rowBytes) {
+    size_t byte = 0;
+    for (; byte + 32 <= rowBytes; byte += 32) {
+        auto topAddress = reinterpret_cast<__m256i *>(top + byte);
+        auto bottomAddress = reinterpret_cast<__m256i *>(bottom + byte);
+
+        auto topBytes = _mm256_loadu_si256(topAddress);
+        _mm256_storeu_si256(topAddress, _mm256_loadu_si256(bottomAddress));
+        _mm256_storeu_si256(bottomAddress, topBytes);
+    }
+
+    return byte;
+}
+
+#endif
+
+namespace framework {
+    SimdLevel simdLevel() {
+        static SimdLevel simdLevel = []() {
+#if defined(PROG2002_X86_64) && defined(_MSC_VER)
+            int registers[4];
+            __cpuid(registers, 1);
+            bool hasSsse3 = registers[2] & (1 << 9);
+
+            // AVX state also needs to be saved by the operating system
+            bool hasOsAvx = (registers[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+
+            __cpuidex(registers, 7, 0);
+            bool hasAvx2 = hasOsAvx && (registers[1] & (1 << 5));
+
+            if (hasAvx2) return SimdLevel::Avx2;
+            if (hasSsse3) return SimdLevel::Ssse3;
+            return SimdLevel::Sse2;
+#elif defined(PROG2002_X86_64)
+            __builtin_cpu_init();
+
+            // Also checks that the operating system saves AVX state
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+            if (__builtin_cpu_supports("ssse3")) return SimdLevel::Ssse3;
+            return SimdLevel::Sse2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }();
+
+        return simdLevel;
+    }
+
+    const char *simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar:
+                return "scalar";
+            case SimdLevel::Sse2:
+                return "SSE2";
+            case SimdLevel::Ssse3:
+                return "SSSE3";
+            case SimdLevel::Avx2:
+                return "AVX2";
+        }
+
+        return "unknown";
+    }
+
+    void expandRgbToRgba(const uint8_t *rgb, uint8_t *rgba, size_t pixelsAmount, SimdLevel level) {
+        size_t done = 0;
+
+#ifdef PROG2002_X86_64
+        // SSE2 has no byte shuffle
+        if (level >= SimdLevel::Avx2) {
+            done = expandRgbToRgbaAvx2(rgb, rgba, pixelsAmount);
+        } else if (level >= SimdLevel::Ssse3) {
+            done = expandRgbToRgbaSsse3(rgb, rgba, pixelsAmount);
+        }
+#endif
+
+        expandRgbToRgbaScalar(rgb, rgba, done, pixelsAmount);
+    }
+
+    void premultiplyAlpha(uint8_t *rgba, size_t pixelsAmount, SimdLevel level) {
+        size_t done = 0;
+
+#ifdef PROG2002_X86_64
+        if (level >= SimdLevel::Avx2) {
+            done = premultiplyAlphaAvx2(rgba, pixelsAmount);
+        } else if (level >= SimdLevel::Sse2) {
+            done = premultiplyAlphaSse2(rgba, pixelsAmount);
+        }
+#endif
+
+        premultiplyAlphaScalar(rgba, done, pixelsAmount);
+    }
+
+    void srgbToLinear(uint8_t *rgba, size_t pixelsAmount, SimdLevel level) {
+        size_t done = 0;
+
+#ifdef PROG2002_X86_64
+        // Table lookups need a gather, which SSE has none of
+        if (level >= SimdLevel::Avx2) {
+            done = srgbToLinearAvx2(rgba, pixelsAmount);
+        }
+#endif
+
+        srgbToLinearScalar(rgba, done, pixelsAmount);
+    }
+
+    void flipVertically(uint8_t *pixels, size_t rowBytes, size_t rows, SimdLevel level) {
+        for (size_t row = 0; row < rows / 2; ++row) {
+            auto top = pixels + row * rowBytes;
+            auto bottom = pixels + (rows - 1 - row) * rowBytes;
+            size_t done = 0;
+
+#ifdef PROG2002_X86_64
+            if (level >= SimdLevel::Avx2) {
+                done = swapRowsAvx2(top, bottom, rowBytes);
+            } else if (level >= SimdLevel::Sse2) {
+                done = swapRowsSse2(top, bottom, rowBytes);
+            }
+#endif
+
+            swapRowsScalar(top, bottom, done, rowBytes);
+        }
+    }
+}
@@ -1,8 +1,10 @@
 #include "framework/IndexBuffer.h"
+#include "framework/FrameStats.h"
 
 namespace framework {
     IndexBuffer::IndexBuffer(std::vector<IndexType> indices) : elementsAmount(indices.size()) {
         glCreateBuffers(1, &indexBufferId);
+        countBufferCreation();
 
         glNamedBufferData(
             indexBufferId,
@@ -10,6 +12,7 @@ namespace framework {
             indices.data(),
             GL_STATIC_DRAW
         );
+        countBufferUpload(indices.size() * sizeof(IndexType));
     }
 
     IndexBuffer::IndexBuffer(IndexBuffer &&object) noexcept:
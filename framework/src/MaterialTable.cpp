@@ -0,0 +1,140 @@
+#include "framework/MaterialTable.h"
+#include "framework/FrameStats.h"
+#include "framework/RenderState.h"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include <cstring>
+
+/**
+ * Entry points of `GL_ARB_bindless_texture`, loaded by hand as the extension is optional
+ */
+struct BindlessFunctions {
+    using GetTextureHandle = GLuint64 (GLAPIENTRY *)(GLuint texture);
+    using MakeTextureHandleResident = void (GLAPIENTRY *)(GLuint64 handle);
+    using MakeTextureHandleNonResident = void (GLAPIENTRY *)(GLuint64 handle);
+
+    GetTextureHandle getTextureHandle = nullptr;
+    MakeTextureHandleResident makeTextureHandleResident = nullptr;
+    MakeTextureHandleNonResident makeTextureHandleNonResident = nullptr;
+};
+
+/**
+ * @return Entry points of `GL_ARB_bindless_texture`, all null if the driver does not support it
+ */
+static const BindlessFunctions &bindlessFunctions() {
+    static BindlessFunctions bindlessFunctions = []() -> BindlessFunctions {
+        int32_t extensionsAmount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionsAmount);
+
+        for (uint32_t extensionIndex = 0; extensionIndex < extensionsAmount; ++extensionIndex) {
+            auto extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, extensionIndex));
+            if (std::strcmp(extension, "GL_ARB_bindless_texture") != 0) continue;
+
+            BindlessFunctions functions = {
+                .getTextureHandle = reinterpret_cast<BindlessFunctions::GetTextureHandle>(
+                    glfwGetProcAddress("glGetTextureHandleARB")
+                ),
+                .makeTextureHandleResident = reinterpret_cast<BindlessFunctions::MakeTextureHandleResident>(
+                    glfwGetProcAddress("glMakeTextureHandleResidentARB")
+                ),
+                .makeTextureHandleNonResident = reinterpret_cast<BindlessFunctions::MakeTextureHandleNonResident>(
+                    glfwGetProcAddress("glMakeTextureHandleNonResidentARB")
+                )
+            };
+
+            bool hasEveryFunction =
+                functions.getTextureHandle &&
+                functions.makeTextureHandleResident &&
+                functions.makeTextureHandleNonResident;
+
+            return hasEveryFunction ? functions : BindlessFunctions();
+        }
+
+        return {};
+    }();
+
+    return bindlessFunctions;
+}
+
+namespace framework {
+    bool hasBindlessTextures() {
+        return bindlessFunctions().getTextureHandle != nullptr;
+    }
+
+    MaterialTable::MaterialTable(
+        std::span<const Image> images,
+        uint32_t binding,
+        bool allowBindless,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps
+    ) : binding(binding) {
+        if (!allowBindless || !hasBindlessTextures()) {
+            textureArray.emplace(createTextureArray(images, filtering, wrapping, mipmaps));
+            return;
+        }
+
+        auto &functions = bindlessFunctions();
+        for (auto &image: images) {
+            auto &texture = textures.emplace_back(
+                createTexture(image, TextureType::Texture2D, filtering, wrapping, mipmaps)
+            );
+            countTextureLoad(texture.memory().gpuBytes);
+
+            // The texture can not be changed after its handle is created
+            auto handle = functions.getTextureHandle(texture.textureId());
+            functions.makeTextureHandleResident(handle);
+            handles.push_back(handle);
+        }
+
+        handleBuffer.emplace(ShaderStorageBuffer<uint64_t>::create(handles));
+    }
+
+    MaterialTable::MaterialTable(MaterialTable &&materialTable) noexcept:
+        binding(materialTable.binding),
+        textures(std::move(materialTable.textures)),
+        handles(std::move(materialTable.handles)),
+        handleBuffer(std::move(materialTable.handleBuffer)),
+        textureArray(std::move(materialTable.textureArray)) {
+        materialTable.handles.clear();
+    }
+
+    MaterialTable::~MaterialTable() {
+        // Textures can only be deleted once their handles are no longer resident
+        for (auto handle: handles) {
+            bindlessFunctions().makeTextureHandleNonResident(handle);
+        }
+    }
+
+    bool MaterialTable::isBindless() const {
+        return !textureArray.has_value();
+    }
+
+    ShaderDefines MaterialTable::shaderDefines() const {
+        ShaderDefines defines = {{"MATERIALS_BINDING", binding}};
+        if (isBindless()) defines.emplace("BINDLESS_MATERIALS", 1);
+
+        return defines;
+    }
+
+    void MaterialTable::bind() const {
+        if (isBindless()) {
+            renderState().bindShaderStorageBuffer(binding, handleBuffer->range());
+        } else {
+            renderState().bindTextureUnit(binding, textureArray->textureId());
+            renderState().bindSampler(binding, 0);
+        }
+    }
+
+    TextureMemory MaterialTable::memory() const {
+        if (!isBindless()) return textureArray->memory();
+
+        TextureMemory memory = {};
+        for (auto &texture: textures) {
+            memory.cpuBytes += texture.memory().cpuBytes;
+            memory.gpuBytes += texture.memory().gpuBytes;
+        }
+
+        return memory;
+    }
+}
@@ -0,0 +1,209 @@
+#include "framework/Mipmaps.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <thread>
+
+/// Shape of the Kaiser window, higher trades sharpness for less ringing
+static const float KAISER_ALPHA = 4.f;
+
+/// Half width of the Kaiser filter, in pixels of the smaller level
+static const float KAISER_RADIUS = 2.f;
+
+/**
+ * Pixels of the level that is being filtered down
+ */
+struct SourceLevel {
+    const uint8_t *pixels;
+    int width;
+    int height;
+};
+
+/**
+ * Split `[0, count)` into one contiguous part per hardware thread and run `work` on each part in parallel
+ */
+static void parallelFor(int count, const std::function<void(int begin, int end)> &work) {
+    int threadsAmount = std::clamp((int) std::thread::hardware_concurrency(), 1, count);
+    int partSize = (count + threadsAmount - 1) / threadsAmount;
+
+    std::vector<std::thread> threads;
+    for (int begin = partSize; begin < count; begin += partSize) {
+        threads.emplace_back(work, begin, std::min(begin + partSize, count));
+    }
+
+    // The calling thread does the first part itself
+    work(0, std::min(partSize, count));
+
+    for (auto &thread: threads) thread.join();
+}
+
+static framework::MipLevel boxDownsample(SourceLevel source) {
+    framework::MipLevel level = {
+        .width = std::max(source.width / 2, 1),
+        .height = std::max(source.height / 2, 1),
+    };
+    level.pixels.resize((size_t) level.width * level.height * 4);
+
+    parallelFor(level.height, [&](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            // Odd sizes and 1 pixel wide levels reuse the last row or column
+            int y0 = std::min(y * 2, source.height - 1);
+            int y1 = std::min(y * 2 + 1, source.height - 1);
+
+            for (int x = 0; x < level.width; ++x) {
+                int x0 = std::min(x * 2, source.width - 1);
+                int x1 = std::min(x * 2 + 1, source.width - 1);
+
+                for (int channel = 0; channel < 4; ++channel) {
+                    auto sourcePixel = [&](int sourceX, int sourceY) {
+                        return (uint32_t) source.pixels[((size_t) sourceY * source.width + sourceX) * 4 + channel];
+                    };
+
+                    auto sum = sourcePixel(x0, y0) + sourcePixel(x1, y0) + sourcePixel(x0, y1) + sourcePixel(x1, y1);
+                    level.pixels[((size_t) y * level.width + x) * 4 + channel] = (uint8_t) ((sum + 2) / 4);
+                }
+            }
+        }
+    });
+
+    return level;
+}
+
+/**
+ * Zeroth order modified Bessel function of the first kind, as a power series
+ */
+static float besselI0(float x) {
+    float sum = 1.f;
+    float term = 1.f;
+
+    for (int k = 1; k < 20; ++k) {
+        term *= (x / (2.f * (float) k)) * (x / (2.f * (float) k));
+        sum += term;
+    }
+
+    return sum;
+}
+
+static float kaiserWeight(float distance) {
+    if (std::abs(distance) >= KAISER_RADIUS) return 0.f;
+
+    float ratio = distance / KAISER_RADIUS;
+    float window = besselI0(KAISER_ALPHA * std::sqrt(1.f - ratio * ratio)) / besselI0(KAISER_ALPHA);
+    float x = std::numbers::pi_v<float> * distance;
+    float sinc = distance == 0.f ? 1.f : std::sin(x) / x;
+
+    return sinc * window;
+}
+
+/**
+ * Taps of a 1D Kaiser filter that scales `sourceSize` pixels down to `levelSize`
+ */
+struct FilterTaps {
+    int first;
+    std::vector<float> weights;
+};
+
+static std::vector<FilterTaps> kaiserTaps(int sourceSize, int levelSize) {
+    float scale = (float) sourceSize / (float) levelSize;
+    std::vector<FilterTaps> taps(levelSize);
+
+    for (int index = 0; index < levelSize; ++index) {
+        float center = ((float) index + 0.5f) * scale - 0.5f;
+        int first = (int) std::ceil(center - KAISER_RADIUS * scale);
+        int last = (int) std::floor(center + KAISER_RADIUS * scale);
+
+        taps[index].first = first;
+
+        float weightsSum = 0.f;
+        for (int sourceIndex = first; sourceIndex <= last; ++sourceIndex) {
+            float weight = kaiserWeight(((float) sourceIndex - center) / scale);
+            taps[index].weights.push_back(weight);
+            weightsSum += weight;
+        }
+
+        for (auto &weight: taps[index].weights) weight /= weightsSum;
+    }
+
+    return taps;
+}
+
+static framework::MipLevel kaiserDownsample(SourceLevel source) {
+    framework::MipLevel level = {
+        .width = std::max(source.width / 2, 1),
+        .height = std::max(source.height / 2, 1),
+    };
+    level.pixels.resize((size_t) level.width * level.height * 4);
+
+    auto horizontalTaps = kaiserTaps(source.width, level.width);
+    auto verticalTaps = kaiserTaps(source.height, level.height);
+
+    // Separable, filter rows into a full height intermediate first
+    std::vector<float> rows((size_t) level.width * source.height * 4);
+
+    parallelFor(source.height, [&](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            for (int x = 0; x < level.width; ++x) {
+                auto &[first, weights] = horizontalTaps[x];
+
+                for (size_t tap = 0; tap < weights.size(); ++tap) {
+                    // Clamp to edge
+                    int sourceX = std::clamp(first + (int) tap, 0, source.width - 1);
+
+                    for (int channel = 0; channel < 4; ++channel) {
+                        rows[((size_t) y * level.width + x) * 4 + channel] +=
+                            weights[tap] * source.pixels[((size_t) y * source.width + sourceX) * 4 + channel];
+                    }
+                }
+            }
+        }
+    });
+
+    parallelFor(level.height, [&](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            auto &[first, weights] = verticalTaps[y];
+
+            for (int x = 0; x < level.width; ++x) {
+                for (int channel = 0; channel < 4; ++channel) {
+                    float value = 0.f;
+
+                    for (size_t tap = 0; tap < weights.size(); ++tap) {
+                        int sourceY = std::clamp(first + (int) tap, 0, source.height - 1);
+                        value += weights[tap] * rows[((size_t) sourceY * level.width + x) * 4 + channel];
+                    }
+
+                    // Negative lobes can overshoot
+                    level.pixels[((size_t) y * level.width + x) * 4 + channel] =
+                        (uint8_t) std::clamp(std::lround(value), 0l, 255l);
+                }
+            }
+        }
+    });
+
+    return level;
+}
+
+namespace framework {
+    uint32_t mipLevelsAmount(int width, int height) {
+        return (uint32_t) std::floor(std::log2((float) std::max(width, height))) + 1;
+    }
+
+    std::vector<MipLevel> generateMipmaps(const uint8_t *pixels, int width, int height, Mipmaps filter) {
+        assert(filter != Mipmaps::Gpu);
+
+        std::vector<MipLevel> levels;
+        auto levelsAmount = mipLevelsAmount(width, height);
+        levels.reserve(levelsAmount - 1);
+
+        SourceLevel source = {.pixels = pixels, .width = width, .height = height};
+
+        for (uint32_t level = 1; level < levelsAmount; ++level) {
+            levels.push_back(filter == Mipmaps::CpuKaiser ? kaiserDownsample(source) : boxDownsample(source));
+            auto &previous = levels.back();
+            source = {.pixels = previous.pixels.data(), .width = previous.width, .height = previous.height};
+        }
+
+        return levels;
+    }
+}
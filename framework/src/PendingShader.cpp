@@ -0,0 +1,229 @@
+#include "framework/PendingShader.h"
+#include "framework/ShaderCache.h"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/**
+ * Whether the driver supports `GL_KHR_parallel_shader_compile`, checked once. Also lets the driver use as many
+ * compiler threads as it wants, as the default is implementation defined.
+ */
+static bool hasParallelShaderCompile() {
+    static bool hasParallelShaderCompile = []() {
+        int32_t extensionsAmount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionsAmount);
+
+        for (uint32_t extensionIndex = 0; extensionIndex < extensionsAmount; ++extensionIndex) {
+            auto extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, extensionIndex));
+            if (std::strcmp(extension, "GL_KHR_parallel_shader_compile") != 0) continue;
+
+            using MaxShaderCompilerThreads = void (GLAPIENTRY *)(GLuint count);
+            auto maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreads>(
+                glfwGetProcAddress("glMaxShaderCompilerThreadsKHR")
+            );
+            if (maxShaderCompilerThreads) maxShaderCompilerThreads(0xFFFFFFFF);
+
+            return true;
+        }
+
+        return false;
+    }();
+
+    return hasParallelShaderCompile;
+}
+
+static uint32_t startCompile(const std::string &source, GLenum shaderType) {
+    uint32_t shaderId = glCreateShader(shaderType);
+
+    const char *rawSource = source.c_str();
+    glShaderSource(shaderId, 1, &rawSource, nullptr);
+    glCompileShader(shaderId);
+
+    return shaderId;
+}
+
+/**
+ * @return Whether the driver is done with the shader, asking never blocks
+ */
+static bool isShaderFinished(uint32_t shaderId) {
+    if (!hasParallelShaderCompile()) return true;
+
+    int32_t isFinished;
+    glGetShaderiv(shaderId, GL_COMPLETION_STATUS_KHR, &isFinished);
+
+    return isFinished;
+}
+
+/**
+ * @return Whether the driver is done with the program, asking never blocks
+ */
+static bool isProgramFinished(uint32_t programId) {
+    if (!hasParallelShaderCompile()) return true;
+
+    int32_t isFinished;
+    glGetProgramiv(programId, GL_COMPLETION_STATUS_KHR, &isFinished);
+
+    return isFinished;
+}
+
+/**
+ * Throw with the info log if the shader failed to compile
+ */
+static void checkCompileStatus(uint32_t shaderId) {
+    int32_t shaderDidCompile;
+    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &shaderDidCompile);
+    if (shaderDidCompile) return;
+
+    int32_t errorLength;
+    glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &errorLength);
+
+    auto errorMessage = std::make_unique<char[]>(errorLength);
+    glGetShaderInfoLog(shaderId, errorLength, &errorLength, errorMessage.get());
+
+    std::cerr << "Failed to compile shader!" << std::endl;
+    std::cerr << errorMessage.get() << std::endl;
+
+    throw std::runtime_error("Failed to compile shader");
+}
+
+/**
+ * Throw with the info log if the program failed to link
+ */
+static void checkLinkStatus(uint32_t programId) {
+    int32_t programDidLink;
+    glGetProgramiv(programId, GL_LINK_STATUS, &programDidLink);
+    if (programDidLink) return;
+
+    int32_t errorLength;
+    glGetProgramiv(programId, GL_INFO_LOG_LENGTH, &errorLength);
+
+    auto errorMessage = std::make_unique<char[]>(errorLength);
+    glGetProgramInfoLog(programId, errorLength, &errorLength, errorMessage.get());
+
+    std::cerr << "Failed to link shader program!" << std::endl;
+    std::cerr << errorMessage.get() << std::endl;
+
+    throw std::runtime_error("Failed to link shader program");
+}
+
+static double millisecondsSince(std::chrono::steady_clock::time_point startTime) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+namespace framework {
+    std::ostream &operator<<(std::ostream &output, const ShaderTiming &timing) {
+        if (timing.wasCached) return output << "loaded from cache in " << timing.linkMilliseconds << " ms";
+
+        return output
+            << "compiled in " << timing.compileMilliseconds << " ms"
+            << ", linked in " << timing.linkMilliseconds << " ms";
+    }
+
+    PendingShader::PendingShader(std::string vertexShaderSource, std::string fragmentShaderSource) :
+        vertexShaderSource(std::move(vertexShaderSource)),
+        fragmentShaderSource(std::move(fragmentShaderSource)),
+        stepStartTime(std::chrono::steady_clock::now()) {
+        auto &cache = shaderCache();
+
+        if (auto cachedProgram = cache.load({this->vertexShaderSource, this->fragmentShaderSource})) {
+            program = cachedProgram.value();
+            step = Step::Done;
+            shaderTiming = {.linkMilliseconds = millisecondsSince(stepStartTime), .wasCached = true};
+            cache.countProgram(true, shaderTiming.linkMilliseconds);
+
+            return;
+        }
+
+        vertexShader = startCompile(this->vertexShaderSource, GL_VERTEX_SHADER);
+        fragmentShader = startCompile(this->fragmentShaderSource, GL_FRAGMENT_SHADER);
+    }
+
+    PendingShader::PendingShader(PendingShader &&pendingShader) noexcept:
+        vertexShaderSource(std::move(pendingShader.vertexShaderSource)),
+        fragmentShaderSource(std::move(pendingShader.fragmentShaderSource)),
+        vertexShader(pendingShader.vertexShader),
+        fragmentShader(pendingShader.fragmentShader),
+        program(pendingShader.program),
+        step(pendingShader.step),
+        stepStartTime(pendingShader.stepStartTime),
+        shaderTiming(pendingShader.shaderTiming) {
+        pendingShader.vertexShader = 0;
+        pendingShader.fragmentShader = 0;
+        pendingShader.program = 0;
+    }
+
+    PendingShader::~PendingShader() {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        if (program) glDeleteProgram(program);
+    }
+
+    bool PendingShader::isReady() {
+        advance(false);
+
+        return step == Step::Done;
+    }
+
+    uint32_t PendingShader::waitForProgram() {
+        advance(true);
+
+        auto programId = program;
+        program = 0;
+
+        return programId;
+    }
+
+    std::shared_ptr<Shader> PendingShader::get() {
+        return std::make_shared<Shader>(waitForProgram());
+    }
+
+    const ShaderTiming &PendingShader::timing() const {
+        return shaderTiming;
+    }
+
+    void PendingShader::advance(bool wait) {
+        auto &cache = shaderCache();
+
+        if (step == Step::Compiling) {
+            if (!wait && !(isShaderFinished(vertexShader) && isShaderFinished(fragmentShader))) return;
+
+            checkCompileStatus(vertexShader);
+            checkCompileStatus(fragmentShader);
+            shaderTiming.compileMilliseconds = millisecondsSince(stepStartTime);
+
+            program = glCreateProgram();
+            if (cache.isEnabled()) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+            glAttachShader(program, vertexShader);
+            glAttachShader(program, fragmentShader);
+            glLinkProgram(program);
+
+            // Attached shaders are only flagged for deletion, and freed together with the program
+            glDeleteShader(vertexShader);
+            glDeleteShader(fragmentShader);
+            vertexShader = 0;
+            fragmentShader = 0;
+
+            step = Step::Linking;
+            stepStartTime = std::chrono::steady_clock::now();
+        }
+
+        if (step == Step::Linking) {
+            if (!wait && !isProgramFinished(program)) return;
+
+            checkLinkStatus(program);
+            shaderTiming.linkMilliseconds = millisecondsSince(stepStartTime);
+
+            cache.store({vertexShaderSource, fragmentShaderSource}, program);
+            cache.countProgram(false, shaderTiming.compileMilliseconds + shaderTiming.linkMilliseconds);
+
+            step = Step::Done;
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "framework/PixelUploadRing.h"
+#include "framework/FrameStats.h"
+#include <algorithm>
+
+static size_t alignUp(size_t offset) {
+    return (offset + framework::PixelUploadRing::ALIGNMENT - 1) / framework::PixelUploadRing::ALIGNMENT
+           * framework::PixelUploadRing::ALIGNMENT;
+}
+
+namespace framework {
+    PixelUploadRing::PixelUploadRing(size_t capacity) : capacity(capacity) {
+        // Coherent, so pixels written on any thread are seen by uploads issued after them without flushing
+        auto flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glCreateBuffers(1, &pixelBufferId);
+        countBufferCreation();
+        glNamedBufferStorage(pixelBufferId, (GLsizeiptr) capacity, nullptr, flags);
+
+        mapping = static_cast<std::byte *>(glMapNamedBufferRange(pixelBufferId, 0, (GLsizeiptr) capacity, flags));
+    }
+
+    PixelUploadRing::~PixelUploadRing() {
+        for (auto &allocation: allocations) {
+            if (allocation.fence) glDeleteSync(allocation.fence);
+        }
+
+        glUnmapNamedBuffer(pixelBufferId);
+        glDeleteBuffers(1, &pixelBufferId);
+    }
+
+    std::optional<PixelUploadRing::Region> PixelUploadRing::reserve(size_t size) {
+        if (size == 0 || size > capacity) return std::nullopt;
+
+        // Offset where `size` bytes fit between the newest region and the oldest one still in use
+        auto place = [this, size]() -> std::optional<size_t> {
+            if (allocations.empty()) return 0;
+
+            auto &oldest = allocations.front();
+            auto &newest = allocations.back();
+            auto head = alignUp(newest.offset + newest.size);
+
+            // Once wrapped around, the free space is between the newest and the oldest region
+            if (newest.offset < oldest.offset) {
+                if (head + size <= oldest.offset) return head;
+
+                return std::nullopt;
+            }
+
+            if (head + size <= capacity) return head;
+            if (size <= oldest.offset) return 0;
+
+            return std::nullopt;
+        };
+
+        std::unique_lock lock(mutex);
+
+        std::optional<size_t> offset;
+        spaceCondition.wait(lock, [&]() {
+            if (isStopping) return true;
+            offset = place();
+
+            return offset.has_value();
+        });
+        if (isStopping) return std::nullopt;
+
+        allocations.push_back({.offset = *offset, .size = size});
+
+        return Region{.offset = *offset, .size = size, .data = mapping + *offset};
+    }
+
+    void PixelUploadRing::retire(const Region &region) {
+        auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        std::lock_guard lock(mutex);
+
+        auto allocation = std::ranges::find_if(allocations, [&region](const Allocation &allocation) {
+            return allocation.offset == region.offset;
+        });
+        if (allocation == allocations.end()) {
+            glDeleteSync(fence);
+            return;
+        }
+
+        allocation->fence = fence;
+        allocation->isRetired = true;
+    }
+
+    bool PixelUploadRing::reclaim() {
+        bool hasReclaimed = false;
+        bool isInUse;
+
+        {
+            std::lock_guard lock(mutex);
+
+            // Regions are freed in ring order, a region still in use keeps every newer one reserved too
+            while (!allocations.empty() && allocations.front().isRetired) {
+                auto fence = allocations.front().fence;
+
+                // Zero timeout, only checks the fence
+                auto status = glClientWaitSync(fence, 0, 0);
+                if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+                glDeleteSync(fence);
+                allocations.pop_front();
+                hasReclaimed = true;
+            }
+
+            isInUse = !allocations.empty();
+        }
+
+        if (hasReclaimed) spaceCondition.notify_all();
+
+        return isInUse;
+    }
+
+    void PixelUploadRing::stop() {
+        {
+            std::lock_guard lock(mutex);
+            isStopping = true;
+        }
+
+        spaceCondition.notify_all();
+    }
+
+    uint32_t PixelUploadRing::bufferId() const {
+        return pixelBufferId;
+    }
+}
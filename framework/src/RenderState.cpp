@@ -0,0 +1,160 @@
+#include "framework/RenderState.h"
+#include "framework/FrameStats.h"
+
+namespace framework {
+    bool RenderState::count(bool shouldIssue) {
+        if (shouldIssue) {
+            frameStats().stateChangesIssued += 1;
+        } else {
+            frameStats().stateChangesSkipped += 1;
+        }
+
+        return shouldIssue;
+    }
+
+    RenderState::RenderState() {
+        invalidate();
+    }
+
+    void RenderState::useProgram(uint32_t programId) {
+        if (!count(program != programId)) return;
+
+        glUseProgram(programId);
+        program = programId;
+    }
+
+    void RenderState::bindVertexArray(uint32_t vertexArrayId) {
+        if (!count(vertexArray != vertexArrayId)) return;
+
+        glBindVertexArray(vertexArrayId);
+        vertexArray = vertexArrayId;
+    }
+
+    void RenderState::bindTextureUnit(uint32_t unit, uint32_t textureId) {
+        if (unit < TEXTURE_UNITS) {
+            if (!count(textures[unit] != textureId)) return;
+            textures[unit] = textureId;
+        }
+
+        glBindTextureUnit(unit, textureId);
+    }
+
+    void RenderState::bindSampler(uint32_t unit, uint32_t samplerId) {
+        if (unit < TEXTURE_UNITS) {
+            if (!count(samplers[unit] != samplerId)) return;
+            samplers[unit] = samplerId;
+        }
+
+        glBindSampler(unit, samplerId);
+    }
+
+    void RenderState::bindUniformBuffer(uint32_t slot, BufferRange range) {
+        if (slot < UNIFORM_BUFFER_BINDINGS) {
+            if (!count(uniformBuffers[slot] != range)) return;
+            uniformBuffers[slot] = range;
+        }
+
+        if (range.size == 0) {
+            glBindBufferBase(GL_UNIFORM_BUFFER, slot, range.bufferId);
+        } else {
+            glBindBufferRange(GL_UNIFORM_BUFFER, slot, range.bufferId, range.offset, range.size);
+        }
+    }
+
+    void RenderState::bindShaderStorageBuffer(uint32_t slot, BufferRange range) {
+        if (slot < SHADER_STORAGE_BUFFER_BINDINGS) {
+            if (!count(shaderStorageBuffers[slot] != range)) return;
+            shaderStorageBuffers[slot] = range;
+        }
+
+        if (range.size == 0) {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, range.bufferId);
+        } else {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot, range.bufferId, range.offset, range.size);
+        }
+    }
+
+    void RenderState::setPolygonMode(GLenum mode) {
+        if (!count(polygonMode != mode)) return;
+
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+        polygonMode = mode;
+    }
+
+    void RenderState::setDepthTest(bool enabled) {
+        if (!count(depthTest != (int) enabled)) return;
+
+        if (enabled) {
+            glEnable(GL_DEPTH_TEST);
+        } else {
+            glDisable(GL_DEPTH_TEST);
+        }
+        depthTest = enabled;
+    }
+
+    void RenderState::setDepthWrite(bool enabled) {
+        if (!count(depthWrite != (int) enabled)) return;
+
+        glDepthMask(enabled);
+        depthWrite = enabled;
+    }
+
+    void RenderState::setDepthFunction(GLenum function) {
+        if (!count(depthFunction != function)) return;
+
+        glDepthFunc(function);
+        depthFunction = function;
+    }
+
+    void RenderState::invalidate() {
+        program = UNKNOWN;
+        vertexArray = UNKNOWN;
+        textures.fill(UNKNOWN);
+        samplers.fill(UNKNOWN);
+        uniformBuffers.fill({.bufferId = UNKNOWN});
+        shaderStorageBuffers.fill({.bufferId = UNKNOWN});
+        polygonMode = UNKNOWN;
+        depthTest = -1;
+        depthWrite = -1;
+        depthFunction = UNKNOWN;
+    }
+
+    void RenderState::forgetProgram(uint32_t programId) {
+        // A deleted program stays in use until another one is used
+        if (program == programId) program = UNKNOWN;
+    }
+
+    void RenderState::forgetVertexArray(uint32_t vertexArrayId) {
+        // Deleting a bound vertex array reverts the binding to zero
+        if (vertexArray == vertexArrayId) vertexArray = 0;
+    }
+
+    void RenderState::forgetTexture(uint32_t textureId) {
+        for (auto &texture: textures) {
+            if (texture == textureId) texture = 0;
+        }
+    }
+
+    void RenderState::forgetSampler(uint32_t samplerId) {
+        // Deleting a bound sampler reverts the binding to zero
+        for (auto &sampler: samplers) {
+            if (sampler == samplerId) sampler = 0;
+        }
+    }
+
+    void RenderState::forgetBuffer(uint32_t bufferId) {
+        for (auto &uniformBuffer: uniformBuffers) {
+            if (uniformBuffer.bufferId == bufferId) uniformBuffer = {.bufferId = 0};
+        }
+
+        for (auto &shaderStorageBuffer: shaderStorageBuffers) {
+            if (shaderStorageBuffer.bufferId == bufferId) shaderStorageBuffer = {.bufferId = 0};
+        }
+    }
+
+    RenderState &renderState() {
+        static RenderState renderState;
+
+        return renderState;
+    }
+}
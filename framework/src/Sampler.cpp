@@ -0,0 +1,131 @@
+#include "framework/Sampler.h"
+#include "framework/RenderState.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#endif
+
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+namespace framework {
+    GLenum glWrapMode(Wrapping wrapping) {
+        switch (wrapping) {
+            case Wrapping::Repeat:
+                return GL_REPEAT;
+            case Wrapping::ClampToEdge:
+                return GL_CLAMP_TO_EDGE;
+            case Wrapping::MirroredRepeat:
+                return GL_MIRRORED_REPEAT;
+            case Wrapping::MirrorClampToEdge:
+                return GL_MIRROR_CLAMP_TO_EDGE;
+        }
+
+        return GL_REPEAT;
+    }
+
+    GLenum glMinFilter(Filtering filtering) {
+        switch (filtering) {
+            case Filtering::Nearest:
+                return GL_NEAREST;
+            case Filtering::Linear:
+                return GL_LINEAR;
+            case Filtering::LinearMipmap:
+                return GL_LINEAR_MIPMAP_LINEAR;
+        }
+
+        return GL_LINEAR;
+    }
+
+    GLenum glMagFilter(Filtering filtering) {
+        return filtering == Filtering::Nearest ? GL_NEAREST : GL_LINEAR;
+    }
+
+    float maxAnisotropy() {
+        static float maxAnisotropy = []() {
+            int32_t extensionsAmount = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &extensionsAmount);
+
+            for (uint32_t extensionIndex = 0; extensionIndex < extensionsAmount; ++extensionIndex) {
+                auto extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, extensionIndex));
+
+                // Core since OpenGL 4.6, drivers still list one of the extensions
+                bool isAnisotropic =
+                    std::strcmp(extension, "GL_ARB_texture_filter_anisotropic") == 0 ||
+                    std::strcmp(extension, "GL_EXT_texture_filter_anisotropic") == 0;
+                if (!isAnisotropic) continue;
+
+                float anisotropy = 1.f;
+                glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &anisotropy);
+
+                return anisotropy;
+            }
+
+            return 1.f;
+        }();
+
+        return maxAnisotropy;
+    }
+
+    Sampler::Sampler(SamplerState state) : id(0) {
+        glCreateSamplers(1, &id);
+
+        auto wrapMode = (int32_t) glWrapMode(state.wrapping);
+        glSamplerParameteri(id, GL_TEXTURE_WRAP_S, wrapMode);
+        glSamplerParameteri(id, GL_TEXTURE_WRAP_T, wrapMode);
+        glSamplerParameteri(id, GL_TEXTURE_WRAP_R, wrapMode);
+
+        glSamplerParameteri(id, GL_TEXTURE_MIN_FILTER, (int32_t) glMinFilter(state.filtering));
+        glSamplerParameteri(id, GL_TEXTURE_MAG_FILTER, (int32_t) glMagFilter(state.filtering));
+
+        if (state.anisotropy > 1.f && maxAnisotropy() > 1.f) {
+            glSamplerParameterf(id, GL_TEXTURE_MAX_ANISOTROPY, std::min(state.anisotropy, maxAnisotropy()));
+        }
+    }
+
+    Sampler::Sampler(Sampler &&sampler) noexcept: id(sampler.id) {
+        sampler.id = 0;
+    }
+
+    Sampler::~Sampler() {
+        if (id) {
+            renderState().forgetSampler(id);
+            glDeleteSamplers(1, &id);
+        }
+    }
+
+    uint32_t Sampler::samplerId() const {
+        return id;
+    }
+
+    void Sampler::bind(uint32_t unit) const {
+        renderState().bindSampler(unit, id);
+    }
+
+    const Sampler &SamplerCache::sampler(SamplerState state) {
+        // Anisotropy above the maximum would give a different key for the same sampler
+        state.anisotropy = std::clamp(state.anisotropy, 1.f, maxAnisotropy());
+
+        auto sampler = samplers.find(state);
+        if (sampler == samplers.end()) sampler = samplers.emplace(state, Sampler(state)).first;
+
+        return sampler->second;
+    }
+
+    size_t SamplerCache::samplersAmount() const {
+        return samplers.size();
+    }
+
+    void SamplerCache::clear() {
+        samplers.clear();
+    }
+
+    SamplerCache &samplerCache() {
+        static SamplerCache samplerCache;
+
+        return samplerCache;
+    }
+}
@@ -1,117 +1,189 @@
 #include "framework/Shader.h"
+#include "framework/RenderState.h"
+#include "framework/FrameStats.h"
+#include "framework/PendingShader.h"
+#include "framework/Trace.h"
 #include "glad/glad.h"
 #include <memory>
 #include <iostream>
-#include <optional>
+#include <unordered_map>
 #include <cassert>
 
 /**
- * @param source
- * @param shaderType
- * @return shaderId if successful
+ * Read the name of an active resource of a program interface
  */
-std::optional<uint32_t> compileShader(const std::string &source, GLenum shaderType) {
-    uint32_t shaderId = glCreateShader(shaderType);
+static std::string programResourceName(uint32_t program, GLenum interface, uint32_t index) {
+    int32_t nameLength;
+    GLenum property = GL_NAME_LENGTH;
+    glGetProgramResourceiv(program, interface, index, 1, &property, 1, nullptr, &nameLength);
 
-    const char *rawSource = source.c_str();
-    glShaderSource(shaderId, 1, &rawSource, nullptr);
-    glCompileShader(shaderId);
+    // Name length includes the null terminator
+    std::string name(nameLength, '\0');
+    glGetProgramResourceName(program, interface, index, nameLength, &nameLength, name.data());
+    name.resize(nameLength);
 
-    int32_t shaderDidCompile;
-    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &shaderDidCompile);
-    if (!shaderDidCompile) {
-        int32_t errorLength;
-        glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &errorLength);
+    return name;
+}
+
+/**
+ * @param program Linked shader program
+ * @return Location of every active uniform that is not part of an uniform block
+ */
+static std::unordered_map<std::string, int32_t> reflectUniformLocations(uint32_t program) {
+    std::unordered_map<std::string, int32_t> uniformLocations;
 
-        auto errorMessage = std::make_unique<char[]>(errorLength);
-        glGetShaderInfoLog(shaderId, errorLength, &errorLength, errorMessage.get());
+    int32_t uniformsAmount;
+    glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformsAmount);
 
-        std::cerr << "Failed to compile shader!" << std::endl;
-        std::cerr << errorMessage.get() << std::endl;
+    for (uint32_t uniformIndex = 0; uniformIndex < uniformsAmount; ++uniformIndex) {
+        int32_t location;
+        GLenum property = GL_LOCATION;
+        glGetProgramResourceiv(program, GL_UNIFORM, uniformIndex, 1, &property, 1, nullptr, &location);
 
-        glDeleteShader(shaderId);
+        // Members of uniform blocks have no location
+        if (location == -1) continue;
 
-        return std::nullopt;
+        auto name = programResourceName(program, GL_UNIFORM, uniformIndex);
+        uniformLocations[name] = location;
+
+        // Arrays are reported as "name[0]", but can also be referred to as "name"
+        if (name.ends_with("[0]")) {
+            uniformLocations[name.substr(0, name.size() - 3)] = location;
+        }
     }
 
-    return shaderId;
+    return uniformLocations;
 }
 
 /**
- * @param vertexShaderSource
- * @param fragmentShaderSource
- * @return Shader program
+ * @param program Linked shader program
+ * @return Index of every active uniform block
  */
-uint32_t createShaderPipeline(const std::string &vertexShaderSource, const std::string &fragmentShaderSource) {
-    uint32_t program = glCreateProgram();
-
-    uint32_t vertexShader = compileShader(vertexShaderSource, GL_VERTEX_SHADER).value();
-    uint32_t fragmentShader = compileShader(fragmentShaderSource, GL_FRAGMENT_SHADER).value();
+static std::unordered_map<std::string, uint32_t> reflectUniformBlockIndices(uint32_t program) {
+    std::unordered_map<std::string, uint32_t> uniformBlockIndices;
 
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
+    int32_t uniformBlocksAmount;
+    glGetProgramInterfaceiv(program, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &uniformBlocksAmount);
 
-    glLinkProgram(program);
-    glValidateProgram(program);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    for (uint32_t blockIndex = 0; blockIndex < uniformBlocksAmount; ++blockIndex) {
+        uniformBlockIndices[programResourceName(program, GL_UNIFORM_BLOCK, blockIndex)] = blockIndex;
+    }
 
-    return program;
+    return uniformBlockIndices;
 }
 
 namespace framework {
     Shader::Shader(const std::string &vertexShaderSource, const std::string &fragmentShaderSource) :
-        id(createShaderPipeline(vertexShaderSource, fragmentShaderSource)) {
+        Shader(PendingShader(vertexShaderSource, fragmentShaderSource).waitForProgram()) {
     }
 
-    Shader::Shader(Shader &&shader) noexcept: id(shader.id) {
+    Shader::Shader(uint32_t programId) :
+        id(programId),
+        uniformLocations(reflectUniformLocations(id)),
+        uniformBlockIndices(reflectUniformBlockIndices(id)) {
+    }
+
+    Shader::Shader(Shader &&shader) noexcept:
+        id(shader.id),
+        uniformLocations(std::move(shader.uniformLocations)),
+        uniformBlockIndices(std::move(shader.uniformBlockIndices)) {
         shader.id = 0;
     }
 
     Shader::~Shader() {
-        if (id) glDeleteProgram(id);
+        if (id) {
+            renderState().forgetProgram(id);
+            glDeleteProgram(id);
+        }
+    }
+
+    UniformLocation Shader::uniformLocation(const std::string &name) const {
+        auto uniform = uniformLocations.find(name);
+        assert(uniform != uniformLocations.end());
+
+        if (uniform == uniformLocations.end()) return {};
+        return {uniform->second};
+    }
+
+    uint32_t Shader::uniformBlockIndex(const std::string &name) const {
+        auto uniformBlock = uniformBlockIndices.find(name);
+        assert(uniformBlock != uniformBlockIndices.end());
+
+        if (uniformBlock == uniformBlockIndices.end()) return GL_INVALID_INDEX;
+        return uniformBlock->second;
+    }
+
+    void Shader::bindUniformBlock(const std::string &name, uint32_t slot) const {
+        glUniformBlockBinding(id, uniformBlockIndex(name), slot);
+    }
+
+    void Shader::uploadUniformBool1(UniformLocation location, bool value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform1i(id, location.location, value);
+    }
+
+    void Shader::uploadUniformInt1(UniformLocation location, int value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform1i(id, location.location, value);
+    }
+
+    void Shader::uploadUniformInt2(UniformLocation location, glm::ivec2 value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform2i(id, location.location, value.x, value.y);
+    }
+
+    void Shader::uploadUniformFloat1(UniformLocation location, float value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform1f(id, location.location, value);
+    }
+
+    void Shader::uploadUniformFloat3(UniformLocation location, glm::vec3 value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform3f(id, location.location, value.r, value.g, value.b);
+    }
+
+    void Shader::uploadUniformFloat4(UniformLocation location, glm::vec4 value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniform4f(id, location.location, value.r, value.g, value.b, value.a);
+    }
+
+    void Shader::uploadUniformMatrix4(UniformLocation location, glm::mat4 value) const {
+        PROG2002_TRACE_SCOPE("Shader::uploadUniform");
+        countUniformUpload();
+        glProgramUniformMatrix4fv(id, location.location, 1, false, &value[0][0]);
     }
 
     void Shader::uploadUniformBool1(const std::string &name, bool value) const {
-        int32_t location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform1i(id, location, value);
+        uploadUniformBool1(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformInt1(const std::string &name, int value) const {
-        int32_t location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform1i(id, location, value);
+        uploadUniformInt1(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformInt2(const std::string &name, glm::ivec2 value) const {
-        auto location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform2i(id, location, value.x, value.y);
+        uploadUniformInt2(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformFloat1(const std::string &name, float value) const {
-        int32_t location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform1f(id, location, value);
+        uploadUniformFloat1(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformFloat3(const std::string &name, glm::vec3 value) const {
-        int32_t location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform3f(id, location, value.r, value.g, value.b);
+        uploadUniformFloat3(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformFloat4(const std::string &name, glm::vec4 value) const {
-        int32_t location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniform4f(id, location, value.r, value.g, value.b, value.a);
+        uploadUniformFloat4(uniformLocation(name), value);
     }
 
     void Shader::uploadUniformMatrix4(const std::string &name, glm::mat4 value) const {
-        auto location = glGetUniformLocation(id, name.c_str());
-        assert(location != -1);
-        glProgramUniformMatrix4fv(id, location, 1, false, &value[0][0]);
+        uploadUniformMatrix4(uniformLocation(name), value);
     }
 }
\ No newline at end of file
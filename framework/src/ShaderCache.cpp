@@ -0,0 +1,156 @@
+#include "framework/ShaderCache.h"
+#include "glad/glad.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+/// Written at the start of every binary file, change it when the file layout changes
+static const uint32_t BINARY_MAGIC = 0x50524f47;
+
+/**
+ * 64 bit FNV-1a, stable between runs and platforms unlike `std::hash`
+ */
+static uint64_t hashBytes(uint64_t hash, const std::string &bytes) {
+    for (unsigned char byte: bytes) {
+        hash ^= byte;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+static std::string glString(GLenum name) {
+    auto string = glGetString(name);
+
+    return string ? reinterpret_cast<const char *>(string) : "";
+}
+
+namespace framework {
+    std::ostream &operator<<(std::ostream &output, const ShaderCacheStats &stats) {
+        return output
+            << "Shader programs: " << stats.programsLoaded + stats.programsCompiled
+            << " (" << stats.programsLoaded << " from cache)"
+            << " in " << stats.milliseconds << " ms";
+    }
+
+    void ShaderCache::enable(const std::filesystem::path &cacheDirectory) {
+        int32_t binaryFormatsAmount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatsAmount);
+
+        if (binaryFormatsAmount == 0) {
+            std::cerr << "Driver has no program binary formats, shader cache disabled" << std::endl;
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(cacheDirectory, error);
+
+        if (error) {
+            std::cerr << "Failed to create shader cache directory: " << error.message() << std::endl;
+            return;
+        }
+
+        directory = cacheDirectory;
+    }
+
+    bool ShaderCache::isEnabled() const {
+        return directory.has_value();
+    }
+
+    std::optional<uint32_t> ShaderCache::load(const std::vector<std::string> &sources) {
+        if (!directory) return std::nullopt;
+
+        std::ifstream file(binaryPath(sources), std::ios::binary);
+        if (!file) return std::nullopt;
+
+        uint32_t magic = 0;
+        GLenum binaryFormat = 0;
+        file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char *>(&binaryFormat), sizeof(binaryFormat));
+        if (!file.good() || magic != BINARY_MAGIC) return std::nullopt;
+
+        // Reading to the end through the buffer never sets eofbit, only a failed read shows up as badbit
+        std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (file.bad() || binary.empty()) return std::nullopt;
+
+        uint32_t program = glCreateProgram();
+        glProgramBinary(program, binaryFormat, binary.data(), (GLsizei) binary.size());
+
+        // Fails when the driver changed since the binary was stored
+        int32_t didLink;
+        glGetProgramiv(program, GL_LINK_STATUS, &didLink);
+        if (!didLink) {
+            glDeleteProgram(program);
+
+            return std::nullopt;
+        }
+
+        return program;
+    }
+
+    void ShaderCache::store(const std::vector<std::string> &sources, uint32_t program) const {
+        if (!directory) return;
+
+        int32_t binaryLength = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength == 0) return;
+
+        std::vector<char> binary(binaryLength);
+        GLenum binaryFormat;
+        glGetProgramBinary(program, binaryLength, &binaryLength, &binaryFormat, binary.data());
+
+        // Write next to the final file and rename, so a crash never leaves a truncated binary behind
+        auto path = binaryPath(sources);
+        auto temporaryPath = std::filesystem::path(path).concat(".tmp");
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(&BINARY_MAGIC), sizeof(BINARY_MAGIC));
+            file.write(reinterpret_cast<const char *>(&binaryFormat), sizeof(binaryFormat));
+            file.write(binary.data(), binaryLength);
+
+            if (!file) return;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, path, error);
+    }
+
+    void ShaderCache::countProgram(bool wasLoaded, double milliseconds) {
+        if (wasLoaded) {
+            stats.programsLoaded++;
+        } else {
+            stats.programsCompiled++;
+        }
+        stats.milliseconds += milliseconds;
+    }
+
+    const ShaderCacheStats &ShaderCache::cacheStats() const {
+        return stats;
+    }
+
+    std::filesystem::path ShaderCache::binaryPath(const std::vector<std::string> &sources) const {
+        // Binaries are only valid for the driver that created them
+        uint64_t hash = 0xcbf29ce484222325;
+        hash = hashBytes(hash, glString(GL_VENDOR));
+        hash = hashBytes(hash, glString(GL_RENDERER));
+        hash = hashBytes(hash, glString(GL_VERSION));
+
+        for (auto &source: sources) {
+            // Separate stages, so moving code between them changes the hash
+            hash = hashBytes(hash, source);
+            hash = hashBytes(hash, std::string(1, '\0'));
+        }
+
+        std::stringstream fileName;
+        fileName << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+
+        return *directory / fileName.str();
+    }
+
+    ShaderCache &shaderCache() {
+        static ShaderCache shaderCache;
+
+        return shaderCache;
+    }
+}
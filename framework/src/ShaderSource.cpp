@@ -0,0 +1,147 @@
+#include "framework/ShaderSource.h"
+#include "framework/FrameUniforms.h"
+#include "framework/MultiDrawBatch.h"
+#include "framework/MaterialTable.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <sstream>
+#include <stdexcept>
+
+/**
+ * Every registered include, with the snippets of the framework registered up front
+ */
+static std::unordered_map<std::string, std::string> &shaderIncludes() {
+    static std::unordered_map<std::string, std::string> shaderIncludes = {
+        {"framework/frame_uniforms.glsl", framework::FRAME_UNIFORMS_GLSL},
+        {"framework/multi_draw.glsl", framework::MULTI_DRAW_GLSL},
+        {"framework/materials.glsl", framework::MATERIALS_GLSL},
+    };
+
+    return shaderIncludes;
+}
+
+/**
+ * @return `line` without leading whitespace
+ */
+static std::string_view trimStart(std::string_view line) {
+    auto start = line.find_first_not_of(" \t");
+
+    return start == std::string_view::npos ? std::string_view() : line.substr(start);
+}
+
+/**
+ * Append `source` to `output` line by line, expanding `#include` directives in place
+ */
+static void expandIncludes(
+    const std::string &source,
+    std::unordered_set<std::string> &includedNames,
+    std::string &output
+) {
+    std::istringstream lines(source);
+    std::string line;
+
+    while (std::getline(lines, line)) {
+        auto directive = trimStart(line);
+
+        if (!directive.starts_with("#include")) {
+            output += line;
+            output += '\n';
+            continue;
+        }
+
+        auto nameStart = directive.find('"');
+        auto nameEnd = directive.find('"', nameStart + 1);
+        if (nameStart == std::string_view::npos || nameEnd == std::string_view::npos) {
+            throw std::runtime_error("Malformed shader include: " + line);
+        }
+
+        auto name = std::string(directive.substr(nameStart + 1, nameEnd - nameStart - 1));
+        if (!includedNames.insert(name).second) continue;
+
+        auto include = shaderIncludes().find(name);
+        if (include == shaderIncludes().end()) {
+            throw std::runtime_error("Unknown shader include: " + name);
+        }
+
+        expandIncludes(include->second, includedNames, output);
+    }
+}
+
+namespace framework {
+    ShaderDefine::ShaderDefine(int value) : value(std::to_string(value)) {}
+
+    ShaderDefine::ShaderDefine(uint32_t value) : value(std::to_string(value) + "u") {}
+
+    ShaderDefine::ShaderDefine(float value) {
+        // Always spell a float literal, even for whole numbers
+        std::ostringstream stream;
+        stream.precision(9);
+        stream << std::showpoint << value;
+        this->value = stream.str();
+    }
+
+    ShaderDefine::ShaderDefine(bool value) : value(value ? "true" : "false") {}
+
+    ShaderDefine::ShaderDefine(const char *value) : value(value) {}
+
+    ShaderDefine::ShaderDefine(std::string value) : value(std::move(value)) {}
+
+    void registerShaderInclude(const std::string &name, const std::string &source) {
+        shaderIncludes()[name] = source;
+    }
+
+    std::string preprocessShader(const std::string &source, const ShaderDefines &defines) {
+        std::string defineLines;
+        for (auto &[name, define]: defines) {
+            defineLines += "#define " + name + " " + define.value + "\n";
+        }
+
+        // `#version` has to stay the first directive, so the defines go right after it
+        std::string versionedSource = source;
+        auto versionStart = source.find("#version");
+        if (versionStart == std::string::npos) {
+            versionedSource.insert(0, defineLines);
+        } else {
+            auto versionEnd = source.find('\n', versionStart);
+            if (versionEnd == std::string::npos) {
+                versionedSource += "\n" + defineLines;
+            } else {
+                versionedSource.insert(versionEnd + 1, defineLines);
+            }
+        }
+
+        std::string output;
+        output.reserve(versionedSource.size());
+
+        std::unordered_set<std::string> includedNames;
+        expandIncludes(versionedSource, includedNames, output);
+
+        return output;
+    }
+
+    ShaderVariants::ShaderVariants(std::string vertexShaderSource, std::string fragmentShaderSource) :
+        vertexShaderSource(std::move(vertexShaderSource)), fragmentShaderSource(std::move(fragmentShaderSource)) {}
+
+    PendingShader &ShaderVariants::compile(const ShaderDefines &defines) {
+        auto variant = variants.find(defines);
+
+        if (variant == variants.end()) {
+            auto pendingShader = PendingShader(
+                preprocessShader(vertexShaderSource, defines),
+                preprocessShader(fragmentShaderSource, defines)
+            );
+            variant = variants.emplace(defines, Variant{.pendingShader = std::move(pendingShader)}).first;
+        }
+
+        return variant->second.pendingShader;
+    }
+
+    std::shared_ptr<Shader> ShaderVariants::variant(const ShaderDefines &defines) {
+        auto &pendingShader = compile(defines);
+        auto &shader = variants.at(defines).shader;
+
+        if (!shader) shader = pendingShader.get();
+
+        return shader;
+    }
+}
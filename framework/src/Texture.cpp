@@ -1,116 +1,710 @@
 #include <iostream>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <cstdlib>
 #include "framework/Texture.h"
+#include "framework/RenderState.h"
+#include "framework/FrameStats.h"
+#include "framework/Sampler.h"
+#include "framework/Trace.h"
+#include "framework/TextureCompression.h"
+#include "glm/ext/vector_int2.hpp"
 #include "glad/glad.h"
+#include "stb_image.h"
 
-struct Pixels {
+/**
+ * RGBA8 pixels for every layer of a texture, a 2D texture has a single layer and a cubemap six
+ */
+struct LayeredPixels {
+    const uint8_t *pixels;
     int width;
     int height;
-    stbi_uc *pixels;
+    int layers;
+
+    /// Whether `pixels` only holds one layer that is used for every layer
+    bool isRepeated;
+
+    /// Whether the layers are those of a texture array, rather than the faces of a cubemap
+    bool isArray = false;
+
+    /// Size of the pixels that are actually held
+    [[nodiscard]] size_t size() const {
+        return (size_t) width * height * 4 * (isRepeated ? 1 : layers);
+    }
 };
 
-static Pixels loadPixels(const std::string &path) {
-    int width, height, bpp;
-    auto pixels = stbi_load(path.c_str(), &width, &height, &bpp, STBI_rgb_alpha);
-    if (!pixels) {
-        throw std::runtime_error("Failed to load pixels");
+/**
+ * Upload `pixels` to `level` of the texture, every layer with a single call unless the layers are repeated. With
+ * `staged` the pixels are read from the pixel unpack buffer instead, and `pixels.pixels` is not used.
+ */
+static void uploadPixels(
+    uint32_t textureId,
+    int level,
+    LayeredPixels pixels,
+    const std::optional<framework::StagedPixels> &staged
+) {
+    auto [_, width, height, layers, isRepeated, isArray] = pixels;
+    const void *source = pixels.pixels;
+
+    if (staged) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staged->pixelBufferId);
+
+        // Offset into the bound buffer, the copy into the texture is only queued on the GPU
+        source = reinterpret_cast<const void *>(staged->offset);
     }
 
-    return {
-        .width = width,
-        .height = height,
-        .pixels = pixels
-    };
+    if (layers == 1) {
+        glTextureSubImage2D(textureId, level, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, source);
+    } else if (isRepeated) {
+        for (int layer = 0; layer < layers; ++layer) {
+            glTextureSubImage3D(textureId, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, source);
+        }
+    } else {
+        glTextureSubImage3D(textureId, level, 0, 0, 0, width, height, layers, GL_RGBA, GL_UNSIGNED_BYTE, source);
+    }
+
+    if (staged) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
-static void applyTextureParameters(uint32_t textureId, framework::Filtering filtering, framework::Wrapping wrapping) {
-    // Wrapping
-    int wrappingInt;
-    switch (wrapping) {
-        case framework::Wrapping::Repeat:
-            wrappingInt = GL_REPEAT;
-            break;
+/**
+ * Filter the mip levels of every layer on the CPU, and upload each level with one call
+ */
+static void uploadCpuMipmaps(
+    uint32_t textureId,
+    LayeredPixels pixels,
+    framework::Mipmaps mipmaps
+) {
+    auto layerSize = (size_t) pixels.width * pixels.height * 4;
+    auto generatedLayers = pixels.isRepeated ? 1 : pixels.layers;
+
+    std::vector<std::vector<framework::MipLevel>> layerLevels;
+    for (int layer = 0; layer < generatedLayers; ++layer) {
+        layerLevels.push_back(
+            framework::generateMipmaps(pixels.pixels + layer * layerSize, pixels.width, pixels.height, mipmaps)
+        );
     }
 
-    glTextureParameteri(textureId, GL_TEXTURE_WRAP_S, wrappingInt);
-    glTextureParameteri(textureId, GL_TEXTURE_WRAP_T, wrappingInt);
-    glTextureParameteri(textureId, GL_TEXTURE_WRAP_R, wrappingInt);
+    for (size_t level = 1; level <= layerLevels[0].size(); ++level) {
+        auto &[width, height, levelPixels] = layerLevels[0][level - 1];
 
-    // Filtering
-    switch (filtering) {
-        case framework::Filtering::Nearest:
-            glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // Layers of a level need to be next to each other
+        std::vector<uint8_t> levelLayers;
+        for (auto &levels: layerLevels) {
+            auto &layerPixels = levels[level - 1].pixels;
+            levelLayers.insert(levelLayers.end(), layerPixels.begin(), layerPixels.end());
+        }
 
-            break;
+        uploadPixels(
+            textureId,
+            (int) level,
+            {levelLayers.data(), width, height, pixels.layers, pixels.isRepeated},
+            std::nullopt
+        );
+    }
+}
 
-        case framework::Filtering::Linear:
-            glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+/**
+ * @return Internal format for the pixels of `image`, without an alpha channel if the file had none
+ */
+static GLenum textureFormat(const framework::Image &image) {
+    if (image.colorSpace == framework::ColorSpace::Srgb) {
+        return image.hasAlpha ? GL_SRGB8_ALPHA8 : GL_SRGB8;
+    }
 
-            break;
+    return image.hasAlpha ? GL_RGBA8 : GL_RGB8;
+}
 
-        case framework::Filtering::LinearMipmap:
-            glGenerateTextureMipmap(textureId);
+/**
+ * Allocate storage for every layer, with a full mip chain when filtering uses mipmaps, and fill it
+ * @return Size of the storage in bytes
+ */
+static size_t storePixels(
+    uint32_t textureId,
+    GLenum internalFormat,
+    LayeredPixels pixels,
+    framework::Filtering filtering,
+    framework::Mipmaps mipmaps,
+    const std::optional<framework::StagedPixels> &staged
+) {
+    uint32_t levelsAmount = filtering == framework::Filtering::LinearMipmap
+                            ? framework::mipLevelsAmount(pixels.width, pixels.height)
+                            : 1;
 
-            glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (pixels.isArray) {
+        auto [_, width, height, layers, isRepeated, isArray] = pixels;
+        glTextureStorage3D(textureId, (GLsizei) levelsAmount, internalFormat, width, height, layers);
+    } else {
+        glTextureStorage2D(textureId, (GLsizei) levelsAmount, internalFormat, pixels.width, pixels.height);
+    }
+    uploadPixels(textureId, 0, pixels, staged);
+
+    size_t bytes = 0;
+    for (uint32_t level = 0; level < levelsAmount; ++level) {
+        bytes += (size_t) std::max(pixels.width >> level, 1) * std::max(pixels.height >> level, 1) * 4 * pixels.layers;
+    }
 
-            break;
+    if (levelsAmount == 1) return bytes;
+
+    if (mipmaps == framework::Mipmaps::Gpu) {
+        glGenerateTextureMipmap(textureId);
+    } else {
+        uploadCpuMipmaps(textureId, pixels, mipmaps);
     }
+
+    return bytes;
+}
+
+/**
+ * Throw unless the mip chain of `staged` pixels can be filled without reading them on the CPU
+ */
+static void checkStagedMipmaps(
+    const std::optional<framework::StagedPixels> &staged,
+    framework::Filtering filtering,
+    framework::Mipmaps mipmaps
+) {
+    if (staged && filtering == framework::Filtering::LinearMipmap && mipmaps != framework::Mipmaps::Gpu) {
+        throw std::runtime_error("Mip levels of staged pixels can only be generated on the GPU");
+    }
+}
+
+/**
+ * Cell of a face in a cross or strip, counted in faces from the top left
+ */
+struct FaceCell {
+    int column;
+    int row;
+
+    /// The bottom face of a vertical cross is stored upside down
+    bool isRotated = false;
+};
+
+/**
+ * @return Cell of every face, in the order of the cubemap layers: +X, -X, +Y, -Y, +Z, -Z
+ */
+static std::array<FaceCell, 6> faceCells(framework::CubemapLayout layout) {
+    switch (layout) {
+        case framework::CubemapLayout::HorizontalCross:
+            return {{{2, 1}, {0, 1}, {1, 0}, {1, 2}, {1, 1}, {3, 1}}};
+
+        case framework::CubemapLayout::VerticalCross:
+            return {{{2, 1}, {0, 1}, {1, 0}, {1, 2}, {1, 1}, {1, 3, true}}};
+
+        case framework::CubemapLayout::HorizontalStrip:
+            return {{{0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {5, 0}}};
+
+        case framework::CubemapLayout::VerticalStrip:
+            return {{{0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5}}};
+
+        default:
+            throw std::runtime_error("Layout has no separate faces");
+    }
+}
+
+/**
+ * @return Size of the image in faces
+ */
+static glm::ivec2 layoutFaces(framework::CubemapLayout layout) {
+    switch (layout) {
+        case framework::CubemapLayout::HorizontalCross:
+            return {4, 3};
+
+        case framework::CubemapLayout::VerticalCross:
+            return {3, 4};
+
+        case framework::CubemapLayout::HorizontalStrip:
+            return {6, 1};
+
+        case framework::CubemapLayout::VerticalStrip:
+            return {1, 6};
+
+        default:
+            return {1, 1};
+    }
+}
+
+/**
+ * Copy every face out of a cross or strip, next to each other in layer order. Each face is copied on its own thread.
+ */
+static std::vector<uint8_t> extractFaces(const framework::Image &image, framework::CubemapLayout layout, int faceSize) {
+    auto faceBytes = (size_t) faceSize * faceSize * 4;
+    std::vector<uint8_t> faces(faceBytes * 6);
+
+    auto cells = faceCells(layout);
+    std::vector<std::future<void>> copies;
+
+    for (int face = 0; face < 6; ++face) {
+        copies.push_back(std::async(std::launch::async, [&, face]() {
+            auto [column, row, isRotated] = cells[face];
+            auto faceStart = faces.data() + face * faceBytes;
+
+            for (int y = 0; y < faceSize; ++y) {
+                int sourceY = row * faceSize + (isRotated ? faceSize - 1 - y : y);
+                auto sourceRow = image.pixels.get() + ((size_t) sourceY * image.width + column * faceSize) * 4;
+                auto faceRow = faceStart + (size_t) y * faceSize * 4;
+
+                if (!isRotated) {
+                    std::memcpy(faceRow, sourceRow, (size_t) faceSize * 4);
+                    continue;
+                }
+
+                // Rotating by 180 degrees also mirrors every row
+                for (int x = 0; x < faceSize; ++x) {
+                    std::memcpy(faceRow + x * 4, sourceRow + (size_t) (faceSize - 1 - x) * 4, 4);
+                }
+            }
+        }));
+    }
+
+    for (auto &copy: copies) copy.get();
+
+    return faces;
+}
+
+/**
+ * Default sampling parameters of the texture, used while no sampler object is bound to its unit
+ */
+static void applyTextureParameters(uint32_t textureId, framework::Filtering filtering, framework::Wrapping wrapping) {
+    auto wrapMode = (int32_t) framework::glWrapMode(wrapping);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_S, wrapMode);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_T, wrapMode);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_R, wrapMode);
+
+    glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, (int32_t) framework::glMinFilter(filtering));
+    glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, (int32_t) framework::glMagFilter(filtering));
+}
+
+/**
+ * Wrap pixels decoded by stb_image with `channels` channels as RGBA8
+ */
+static framework::Image decodedImage(uint8_t *pixels, int width, int height, int channels) {
+    if (channels == 3) {
+        auto pixelsAmount = (size_t) width * height;
+
+        // Freed with `std::free` like the pixels of stb_image
+        auto rgbaPixels = static_cast<uint8_t *>(std::malloc(pixelsAmount * 4));
+        if (rgbaPixels) framework::expandRgbToRgba(pixels, rgbaPixels, pixelsAmount);
+        stbi_image_free(pixels);
+
+        if (!rgbaPixels) throw std::runtime_error("Failed to allocate pixels");
+        pixels = rgbaPixels;
+    }
+
+    return {
+        .width = width,
+        .height = height,
+        .pixels = std::unique_ptr<uint8_t, framework::ImageDeleter>(pixels),
+        .hasAlpha = channels == 2 || channels == 4
+    };
 }
 
 namespace framework {
-    Texture::Texture(uint32_t id, stbi_uc *pixels) : id(id), pixels(pixels) {}
+    std::ostream &operator<<(std::ostream &output, const TextureMemory &memory) {
+        return output << memory.cpuBytes << " bytes on the CPU, " << memory.gpuBytes << " bytes on the GPU";
+    }
+
+    Texture::Texture(uint32_t id, TextureMemory memory) : id(id), textureMemory(memory) {}
+
+    Texture::Texture(Texture &&texture) noexcept: id(texture.id), textureMemory(texture.textureMemory) {
+        texture.id = 0;
+        texture.textureMemory = {};
+    }
+
+    Texture &Texture::operator=(Texture &&texture) noexcept {
+        if (this == &texture) return *this;
+
+        if (id) {
+            renderState().forgetTexture(id);
+            glDeleteTextures(1, &id);
+        }
 
-    Texture::Texture(Texture &&texture) noexcept: id(texture.id), pixels(texture.pixels) {
+        id = texture.id;
+        textureMemory = texture.textureMemory;
         texture.id = 0;
-        texture.pixels = nullptr;
+        texture.textureMemory = {};
+
+        return *this;
     }
 
     Texture::~Texture() {
-        if (id) glDeleteTextures(1, &id);
-        if (pixels) stbi_image_free((void *) pixels);
+        if (id) {
+            renderState().forgetTexture(id);
+            glDeleteTextures(1, &id);
+        }
     }
 
     void Texture::bind() const {
-        glBindTextureUnit(0, id);
+        renderState().bindTextureUnit(0, id);
+        renderState().bindSampler(0, 0);
+    }
+
+    uint32_t Texture::textureId() const {
+        return id;
+    }
+
+    const TextureMemory &Texture::memory() const {
+        return textureMemory;
+    }
+
+    void ImageDeleter::operator()(uint8_t *pixels) const {
+        // Same as `stbi_image_free`, so pixels expanded by the framework can be freed alike
+        std::free(pixels);
+    }
+
+    Image decodeImage(const std::string &path) {
+        PROG2002_TRACE_FUNCTION();
+
+        int width, height, channels;
+        if (!stbi_info(path.c_str(), &width, &height, &channels)) {
+            throw std::runtime_error("Failed to load pixels");
+        }
+
+        // RGB is decoded as is and expanded with SIMD, which is faster than letting stb_image do it
+        auto pixels = stbi_load(path.c_str(), &width, &height, &channels, channels == 3 ? STBI_rgb : STBI_rgb_alpha);
+        if (!pixels) {
+            throw std::runtime_error("Failed to load pixels");
+        }
+
+        return decodedImage(pixels, width, height, channels);
+    }
+
+    Image decodeImage(std::span<const std::byte> data) {
+        PROG2002_TRACE_FUNCTION();
+
+        auto bytes = reinterpret_cast<const stbi_uc *>(data.data());
+
+        int width, height, channels;
+        if (!stbi_info_from_memory(bytes, (int) data.size(), &width, &height, &channels)) {
+            throw std::runtime_error("Failed to load pixels");
+        }
+
+        auto pixels = stbi_load_from_memory(
+            bytes,
+            (int) data.size(),
+            &width,
+            &height,
+            &channels,
+            channels == 3 ? STBI_rgb : STBI_rgb_alpha
+        );
+        if (!pixels) {
+            throw std::runtime_error("Failed to load pixels");
+        }
+
+        return decodedImage(pixels, width, height, channels);
+    }
+
+    void processImage(Image &image, const ImageProcessing &processing) {
+        auto pixelsAmount = (size_t) image.width * image.height;
+        image.colorSpace = processing.colorSpace;
+
+        if (processing.convertToLinear && image.colorSpace == ColorSpace::Srgb) {
+            srgbToLinear(image.pixels.get(), pixelsAmount);
+            image.colorSpace = ColorSpace::Linear;
+        }
+
+        if (processing.premultiplyAlpha && image.hasAlpha) {
+            premultiplyAlpha(image.pixels.get(), pixelsAmount);
+        }
+
+        if (processing.flipVertically) {
+            flipVertically(image.pixels.get(), (size_t) image.width * 4, image.height);
+        }
+    }
+
+    Texture createTexture(
+        const Image &image,
+        TextureType type,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps,
+        const std::optional<StagedPixels> &staged
+    ) {
+        if (type == TextureType::Cubemap) {
+            return createCubemap(image, CubemapLayout::SameOnEveryFace, filtering, wrapping, mipmaps, staged);
+        }
+
+        checkStagedMipmaps(staged, filtering, mipmaps);
+
+        uint32_t textureId;
+        glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
+
+        auto gpuBytes = storePixels(
+            textureId,
+            textureFormat(image),
+            {image.pixels.get(), image.width, image.height, 1, false},
+            filtering,
+            mipmaps,
+            staged
+        );
+
+        applyTextureParameters(textureId, filtering, wrapping);
+
+        return {textureId, {.cpuBytes = 0, .gpuBytes = gpuBytes}};
+    }
+
+    Texture createCubemap(
+        const Image &image,
+        CubemapLayout layout,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps,
+        const std::optional<StagedPixels> &staged
+    ) {
+        if (staged && layout != CubemapLayout::SameOnEveryFace) {
+            throw std::runtime_error("Faces can only be cut out of pixels on the CPU, not staged ones");
+        }
+        checkStagedMipmaps(staged, filtering, mipmaps);
+
+        auto faces = layoutFaces(layout);
+        int faceSize = image.width / faces.x;
+
+        if (image.width % faces.x != 0 || image.height != faceSize * faces.y) {
+            throw std::runtime_error("Image size does not match the cubemap layout");
+        }
+
+        uint32_t textureId;
+        glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &textureId);
+
+        size_t gpuBytes;
+        if (layout == CubemapLayout::SameOnEveryFace) {
+            gpuBytes = storePixels(
+                textureId,
+                textureFormat(image),
+                {image.pixels.get(), faceSize, faceSize, 6, true},
+                filtering,
+                mipmaps,
+                staged
+            );
+        } else {
+            auto facePixels = extractFaces(image, layout, faceSize);
+            gpuBytes = storePixels(
+                textureId,
+                textureFormat(image),
+                {facePixels.data(), faceSize, faceSize, 6, false},
+                filtering,
+                mipmaps,
+                std::nullopt
+            );
+        }
+
+        applyTextureParameters(textureId, filtering, wrapping);
+
+        return {textureId, {.cpuBytes = 0, .gpuBytes = gpuBytes}};
+    }
+
+    Texture createTextureArray(
+        std::span<const Image> images,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps
+    ) {
+        if (images.empty()) throw std::runtime_error("A texture array needs at least one layer");
+
+        int width = images[0].width;
+        int height = images[0].height;
+        auto layerBytes = (size_t) width * height * 4;
+
+        for (auto &image: images) {
+            if (image.width != width || image.height != height) {
+                throw std::runtime_error("Every layer of a texture array needs the same size");
+            }
+        }
+
+        // Layers next to each other, to upload them with one call
+        std::vector<uint8_t> layerPixels(layerBytes * images.size());
+        for (size_t layer = 0; layer < images.size(); ++layer) {
+            std::memcpy(layerPixels.data() + layer * layerBytes, images[layer].pixels.get(), layerBytes);
+        }
+
+        uint32_t textureId;
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &textureId);
+
+        auto gpuBytes = storePixels(
+            textureId,
+            textureFormat(images[0]),
+            {layerPixels.data(), width, height, (int) images.size(), false, true},
+            filtering,
+            mipmaps,
+            std::nullopt
+        );
+
+        applyTextureParameters(textureId, filtering, wrapping);
+        countTextureLoad(gpuBytes);
+
+        return {textureId, {.cpuBytes = 0, .gpuBytes = gpuBytes}};
+    }
+
+    Texture createPlaceholderTexture(TextureType type) {
+        const uint8_t gray[4] = {128, 128, 128, 255};
+
+        uint32_t textureId;
+        glCreateTextures(type == TextureType::Cubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 1, &textureId);
+        glTextureStorage2D(textureId, 1, GL_RGBA8, 1, 1);
+
+        if (type == TextureType::Cubemap) {
+            for (int face = 0; face < 6; ++face) {
+                glTextureSubImage3D(textureId, 0, 0, 0, face, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, gray);
+            }
+        } else {
+            glTextureSubImage2D(textureId, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, gray);
+        }
+
+        applyTextureParameters(textureId, Filtering::Nearest, Wrapping::Repeat);
+
+        return {textureId, {.cpuBytes = 0, .gpuBytes = 4 * (size_t) (type == TextureType::Cubemap ? 6 : 1)}};
     }
 
     Texture loadTexture(
         const std::string &path,
         Filtering filtering,
-        Wrapping wrapping
+        Wrapping wrapping,
+        Mipmaps mipmaps,
+        const ImageProcessing &processing
+    ) {
+        PROG2002_TRACE_FUNCTION();
+
+        // The decoded image is freed as soon as it is uploaded
+        auto image = decodeImage(path);
+        processImage(image, processing);
+
+        auto texture = createTexture(image, TextureType::Texture2D, filtering, wrapping, mipmaps);
+        countTextureLoad(texture.memory().gpuBytes);
+
+        return texture;
+    }
+
+    Texture loadTexture(
+        std::span<const std::byte> data,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps,
+        const ImageProcessing &processing
+    ) {
+        PROG2002_TRACE_FUNCTION();
+
+        auto image = decodeImage(data);
+        processImage(image, processing);
+
+        auto texture = createTexture(image, TextureType::Texture2D, filtering, wrapping, mipmaps);
+        countTextureLoad(texture.memory().gpuBytes);
+
+        return texture;
+    }
+
+    Texture loadCubemap(
+        const std::string &path,
+        CubemapLayout layout,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps,
+        const ImageProcessing &processing
     ) {
-        auto [imageWidth, imageHeight, pixels] = loadPixels(path);
+        PROG2002_TRACE_FUNCTION();
+
+        auto image = decodeImage(path);
+        processImage(image, processing);
+
+        auto texture = createCubemap(image, layout, filtering, wrapping, mipmaps);
+        countTextureLoad(texture.memory().gpuBytes);
+
+        return texture;
+    }
+
+    Texture loadCompressedTexture(const std::string &path, Filtering filtering, Wrapping wrapping) {
+        PROG2002_TRACE_FUNCTION();
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Failed to open " + path);
+
+        std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        return loadCompressedTexture(std::as_bytes(std::span(contents)), filtering, wrapping);
+    }
+
+    Texture loadCompressedTexture(std::span<const std::byte> data, Filtering filtering, Wrapping wrapping) {
+        PROG2002_TRACE_FUNCTION();
+
+        auto [format, levels] = parseCompressedTexture(data);
+        auto glFormat = compressedGlFormat(format);
 
         uint32_t textureId;
         glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
+        glTextureStorage2D(textureId, (GLsizei) levels.size(), glFormat, levels[0].width, levels[0].height);
+
+        size_t gpuBytes = 0;
+        for (int level = 0; level < levels.size(); ++level) {
+            auto &[width, height, blocks] = levels[level];
 
-        glTextureStorage2D(textureId, 1, GL_RGBA8, imageWidth, imageHeight);
-        glTextureSubImage2D(textureId, 0, 0, 0, imageWidth, imageHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            glCompressedTextureSubImage2D(
+                textureId, level, 0, 0, width, height, glFormat, (GLsizei) blocks.size(), blocks.data()
+            );
+            gpuBytes += blocks.size();
+        }
 
+        // Mipmapped filtering needs every level of the chain
+        auto isMipChainComplete = levels.size() == mipLevelsAmount(levels[0].width, levels[0].height);
+        if (filtering == Filtering::LinearMipmap && !isMipChainComplete) filtering = Filtering::Linear;
         applyTextureParameters(textureId, filtering, wrapping);
+        countTextureLoad(gpuBytes);
 
-        return {textureId, pixels};
+        return {textureId, {.cpuBytes = 0, .gpuBytes = gpuBytes}};
     }
 
     Texture loadCubemap(
-        const std::string &path,
+        const std::array<std::string, 6> &facePaths,
         Filtering filtering,
-        Wrapping wrapping
+        Wrapping wrapping,
+        Mipmaps mipmaps
     ) {
-        auto [imageWidth, imageHeight, pixels] = loadPixels(path);
+        PROG2002_TRACE_FUNCTION();
+
+        // Decode every face on its own thread
+        std::array<std::future<Image>, 6> decodes;
+        for (int face = 0; face < 6; ++face) {
+            decodes[face] = std::async(std::launch::async, [&path = facePaths[face]]() { return decodeImage(path); });
+        }
+
+        std::array<Image, 6> images;
+        for (int face = 0; face < 6; ++face) {
+            images[face] = decodes[face].get();
+        }
+
+        int faceSize = images[0].width;
+        auto faceBytes = (size_t) faceSize * faceSize * 4;
+
+        for (auto &image: images) {
+            if (image.width != faceSize || image.height != faceSize) {
+                throw std::runtime_error("Cubemap faces need to be square and of the same size");
+            }
+        }
+
+        // Faces next to each other, to upload them with one call
+        std::vector<uint8_t> facePixels(faceBytes * 6);
+        for (int face = 0; face < 6; ++face) {
+            std::memcpy(facePixels.data() + face * faceBytes, images[face].pixels.get(), faceBytes);
+            images[face].pixels.reset();
+        }
 
         uint32_t textureId;
         glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &textureId);
 
-        glTextureStorage2D(textureId, 1, GL_RGBA8, imageWidth, imageHeight);
-        for (int i = 0; i < 6; ++i) {
-            glTextureSubImage3D(textureId, 0, 0, 0, i, imageWidth, imageHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-        }
+        auto gpuBytes = storePixels(
+            textureId,
+            textureFormat(images[0]),
+            {facePixels.data(), faceSize, faceSize, 6, false},
+            filtering,
+            mipmaps,
+            std::nullopt
+        );
 
         applyTextureParameters(textureId, filtering, wrapping);
+        countTextureLoad(gpuBytes);
 
-        return {textureId, pixels};
+        return {textureId, {.cpuBytes = 0, .gpuBytes = gpuBytes}};
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,311 @@
+#include "framework/TextureCompression.h"
+#include "framework/Mipmaps.h"
+#include "glad/glad.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+/// Identifies the file type, ends with a version number
+static const char FILE_IDENTIFIER[8] = {'P', 'R', 'O', 'G', 'T', 'E', 'X', '1'};
+
+/// Alignment of the data of every level
+static const uint64_t LEVEL_ALIGNMENT = 16;
+
+struct FileHeader {
+    char identifier[8];
+    framework::CompressedFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelsAmount;
+};
+
+struct LevelIndex {
+    uint64_t offset;
+    uint64_t size;
+};
+
+/// RGBA8 pixels of a 4x4 block, row by row
+using Block = std::array<std::array<uint8_t, 4>, 16>;
+
+static uint16_t toRgb565(const std::array<int, 3> &color) {
+    int red = (color[0] * 31 + 127) / 255;
+    int green = (color[1] * 63 + 127) / 255;
+    int blue = (color[2] * 31 + 127) / 255;
+
+    return (uint16_t) (red << 11 | green << 5 | blue);
+}
+
+static std::array<int, 3> fromRgb565(uint16_t color) {
+    int red = (color >> 11) & 31;
+    int green = (color >> 5) & 63;
+    int blue = color & 31;
+
+    return {(red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2)};
+}
+
+/**
+ * Encode the colors of `block` with endpoints at the corners of its bounding box, always in 4 color mode
+ */
+static void compressColorBlock(const Block &block, uint8_t *output) {
+    std::array<int, 3> minimum = {255, 255, 255};
+    std::array<int, 3> maximum = {0, 0, 0};
+
+    for (auto &pixel: block) {
+        for (int channel = 0; channel < 3; ++channel) {
+            minimum[channel] = std::min(minimum[channel], (int) pixel[channel]);
+            maximum[channel] = std::max(maximum[channel], (int) pixel[channel]);
+        }
+    }
+
+    // Move the endpoints inwards a little, interpolated colors then cover the box better
+    for (int channel = 0; channel < 3; ++channel) {
+        int inset = (maximum[channel] - minimum[channel]) / 16;
+        minimum[channel] += inset;
+        maximum[channel] -= inset;
+    }
+
+    uint16_t color0 = toRgb565(maximum);
+    uint16_t color1 = toRgb565(minimum);
+
+    // Color 0 has to be the larger one for 4 color mode
+    if (color0 < color1) std::swap(color0, color1);
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        auto endpoint0 = fromRgb565(color0);
+        auto endpoint1 = fromRgb565(color1);
+
+        std::array<std::array<int, 3>, 4> palette;
+        for (int channel = 0; channel < 3; ++channel) {
+            palette[0][channel] = endpoint0[channel];
+            palette[1][channel] = endpoint1[channel];
+            palette[2][channel] = (2 * endpoint0[channel] + endpoint1[channel]) / 3;
+            palette[3][channel] = (endpoint0[channel] + 2 * endpoint1[channel]) / 3;
+        }
+
+        for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex) {
+            auto &pixel = block[pixelIndex];
+
+            int bestIndex = 0;
+            int bestDistance = INT32_MAX;
+            for (int paletteIndex = 0; paletteIndex < 4; ++paletteIndex) {
+                int distance = 0;
+                for (int channel = 0; channel < 3; ++channel) {
+                    int difference = pixel[channel] - palette[paletteIndex][channel];
+                    distance += difference * difference;
+                }
+
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = paletteIndex;
+                }
+            }
+
+            indices |= (uint32_t) bestIndex << (pixelIndex * 2);
+        }
+    }
+
+    std::memcpy(output, &color0, 2);
+    std::memcpy(output + 2, &color1, 2);
+    std::memcpy(output + 4, &indices, 4);
+}
+
+/**
+ * Encode the alpha of `block` with its minimum and maximum as endpoints, in 8 value mode
+ */
+static void compressAlphaBlock(const Block &block, uint8_t *output) {
+    int alpha0 = 0;
+    int alpha1 = 255;
+    for (auto &pixel: block) {
+        alpha0 = std::max(alpha0, (int) pixel[3]);
+        alpha1 = std::min(alpha1, (int) pixel[3]);
+    }
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        std::array<int, 8> palette = {alpha0, alpha1};
+        for (int step = 1; step < 7; ++step) {
+            palette[step + 1] = ((7 - step) * alpha0 + step * alpha1) / 7;
+        }
+
+        for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex) {
+            int bestIndex = 0;
+            for (int paletteIndex = 1; paletteIndex < 8; ++paletteIndex) {
+                if (std::abs(block[pixelIndex][3] - palette[paletteIndex])
+                    < std::abs(block[pixelIndex][3] - palette[bestIndex])) {
+                    bestIndex = paletteIndex;
+                }
+            }
+
+            indices |= (uint64_t) bestIndex << (pixelIndex * 3);
+        }
+    }
+
+    output[0] = (uint8_t) alpha0;
+    output[1] = (uint8_t) alpha1;
+
+    // 48 bits of indices, little endian
+    for (int byte = 0; byte < 6; ++byte) {
+        output[2 + byte] = (uint8_t) (indices >> (byte * 8));
+    }
+}
+
+namespace framework {
+    size_t compressedSize(CompressedFormat format, int width, int height) {
+        size_t blocks = (size_t) ((width + 3) / 4) * ((height + 3) / 4);
+
+        return blocks * (format == CompressedFormat::Bc1 ? 8 : 16);
+    }
+
+    uint32_t compressedGlFormat(CompressedFormat format) {
+        switch (format) {
+            case CompressedFormat::Bc1:
+                return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+
+            case CompressedFormat::Bc3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        }
+
+        throw std::runtime_error("Unknown compressed format");
+    }
+
+    std::vector<uint8_t> compressPixels(const uint8_t *pixels, int width, int height, CompressedFormat format) {
+        std::vector<uint8_t> blocks(compressedSize(format, width, height));
+        auto output = blocks.data();
+
+        for (int blockY = 0; blockY < height; blockY += 4) {
+            for (int blockX = 0; blockX < width; blockX += 4) {
+                Block block;
+                for (int y = 0; y < 4; ++y) {
+                    for (int x = 0; x < 4; ++x) {
+                        int pixelX = std::min(blockX + x, width - 1);
+                        int pixelY = std::min(blockY + y, height - 1);
+                        std::memcpy(block[y * 4 + x].data(), pixels + ((size_t) pixelY * width + pixelX) * 4, 4);
+                    }
+                }
+
+                if (format == CompressedFormat::Bc3) {
+                    compressAlphaBlock(block, output);
+                    output += 8;
+                }
+
+                compressColorBlock(block, output);
+                output += 8;
+            }
+        }
+
+        return blocks;
+    }
+
+    void writeCompressedTexture(const std::string &path, const CompressedTexture &texture) {
+        FileHeader header = {
+            .format = texture.format,
+            .width = (uint32_t) texture.levels[0].width,
+            .height = (uint32_t) texture.levels[0].height,
+            .levelsAmount = (uint32_t) texture.levels.size()
+        };
+        std::memcpy(header.identifier, FILE_IDENTIFIER, sizeof(FILE_IDENTIFIER));
+
+        std::vector<LevelIndex> levelIndices;
+        uint64_t offset = sizeof(FileHeader) + sizeof(LevelIndex) * texture.levels.size();
+        for (auto &level: texture.levels) {
+            offset = (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+            levelIndices.push_back({.offset = offset, .size = level.blocks.size()});
+            offset += level.blocks.size();
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(levelIndices.data()), sizeof(LevelIndex) * levelIndices.size());
+
+        for (size_t level = 0; level < texture.levels.size(); ++level) {
+            // Pad up to the aligned offset
+            std::vector<char> padding(levelIndices[level].offset - (uint64_t) file.tellp(), 0);
+            file.write(padding.data(), (std::streamsize) padding.size());
+
+            auto &blocks = texture.levels[level].blocks;
+            file.write(reinterpret_cast<const char *>(blocks.data()), (std::streamsize) blocks.size());
+        }
+
+        if (!file) throw std::runtime_error("Failed to write " + path);
+    }
+
+    CompressedTexture readCompressedTexture(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Failed to open " + path);
+
+        std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto [format, levelViews] = parseCompressedTexture(std::as_bytes(std::span(contents)));
+
+        CompressedTexture texture = {.format = format};
+        for (auto &[width, height, blocks]: levelViews) {
+            texture.levels.push_back(
+                {.width = width, .height = height, .blocks = std::vector<uint8_t>(blocks.begin(), blocks.end())}
+            );
+        }
+
+        return texture;
+    }
+
+    CompressedTextureView parseCompressedTexture(std::span<const std::byte> data) {
+        FileHeader header;
+        if (data.size() < sizeof(header)) throw std::runtime_error("Truncated compressed texture");
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (std::memcmp(header.identifier, FILE_IDENTIFIER, sizeof(FILE_IDENTIFIER)) != 0) {
+            throw std::runtime_error("Not a compressed texture");
+        }
+        if (header.format != CompressedFormat::Bc1 && header.format != CompressedFormat::Bc3) {
+            throw std::runtime_error("Unknown compressed format");
+        }
+        if (header.width == 0 || header.height == 0 || header.width > INT32_MAX || header.height > INT32_MAX) {
+            throw std::runtime_error("Corrupt compressed texture");
+        }
+
+        // Also keeps the shifts below the width of the size
+        auto maxLevelsAmount = mipLevelsAmount((int) header.width, (int) header.height);
+        if (header.levelsAmount == 0 || header.levelsAmount > maxLevelsAmount) {
+            throw std::runtime_error("Corrupt compressed texture");
+        }
+        if (data.size() < sizeof(header) + sizeof(LevelIndex) * header.levelsAmount) {
+            throw std::runtime_error("Truncated compressed texture");
+        }
+
+        std::vector<LevelIndex> levelIndices(header.levelsAmount);
+        std::memcpy(levelIndices.data(), data.data() + sizeof(header), sizeof(LevelIndex) * levelIndices.size());
+
+        CompressedTextureView texture = {.format = header.format};
+        for (uint32_t level = 0; level < header.levelsAmount; ++level) {
+            int width = std::max((int) header.width >> level, 1);
+            int height = std::max((int) header.height >> level, 1);
+
+            auto [offset, size] = levelIndices[level];
+            if (size != compressedSize(header.format, width, height)) {
+                throw std::runtime_error("Corrupt compressed texture");
+            }
+            if (offset > data.size() || size > data.size() - offset) throw std::runtime_error("Truncated compressed texture");
+
+            texture.levels.push_back(
+                {
+                    .width = width,
+                    .height = height,
+                    .blocks = {reinterpret_cast<const uint8_t *>(data.data() + offset), size}
+                }
+            );
+        }
+
+        return texture;
+    }
+}
@@ -0,0 +1,231 @@
+#include "framework/TextureStreamer.h"
+#include "framework/window.h"
+#include "framework/Trace.h"
+#include "framework/FrameStats.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace framework {
+    TextureStreamer::TextureStreamer(GLFWwindow *window, uint32_t decodeThreadsAmount) :
+        uploadContext(createSharedContext(window)), pixelUploadRing(STAGING_BYTES) {
+        if (decodeThreadsAmount == 0) {
+            decodeThreadsAmount = std::max((int) std::thread::hardware_concurrency() - 1, 1);
+        }
+
+        for (uint32_t thread = 0; thread < decodeThreadsAmount; ++thread) {
+            decodeThreads.emplace_back(&TextureStreamer::decodeImages, this);
+        }
+        uploadThread = std::thread(&TextureStreamer::uploadImages, this);
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        {
+            std::lock_guard lock(mutex);
+            isStopping = true;
+        }
+        decodeCondition.notify_all();
+        uploadCondition.notify_all();
+        pixelUploadRing.stop();
+
+        for (auto &thread: decodeThreads) thread.join();
+        uploadThread.join();
+
+        // The upload thread has released the upload context, what is left is deleted through the main context
+        assert(glfwGetCurrentContext() != nullptr);
+
+        for (auto &uploadedTexture: uploadedTextures) {
+            glDeleteSync(uploadedTexture.fence);
+        }
+        uploadedTextures.clear();
+
+        glfwDestroyWindow(uploadContext);
+    }
+
+    std::shared_ptr<Texture> TextureStreamer::load(
+        const std::string &path,
+        TextureType type,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps
+    ) {
+        return queue({.path = path, .type = type, .filtering = filtering, .wrapping = wrapping, .mipmaps = mipmaps});
+    }
+
+    std::shared_ptr<Texture> TextureStreamer::load(
+        std::span<const std::byte> data,
+        TextureType type,
+        Filtering filtering,
+        Wrapping wrapping,
+        Mipmaps mipmaps
+    ) {
+        return queue({.data = data, .type = type, .filtering = filtering, .wrapping = wrapping, .mipmaps = mipmaps});
+    }
+
+    std::shared_ptr<Texture> TextureStreamer::queue(Request request) {
+        auto texture = std::make_shared<Texture>(createPlaceholderTexture(request.type));
+        request.texture = texture;
+
+        {
+            std::lock_guard lock(mutex);
+            decodeQueue.push_back(std::move(request));
+            pendingAmount++;
+        }
+        decodeCondition.notify_one();
+
+        return texture;
+    }
+
+    void TextureStreamer::update() {
+        std::vector<UploadedTexture> finishedTextures;
+        {
+            std::lock_guard lock(mutex);
+
+            auto unfinished = std::partition(
+                uploadedTextures.begin(),
+                uploadedTextures.end(),
+                [](const UploadedTexture &uploadedTexture) {
+                    // Zero timeout, only checks the fence
+                    auto status = glClientWaitSync(uploadedTexture.fence, 0, 0);
+                    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+                }
+            );
+
+            std::move(uploadedTextures.begin(), unfinished, std::back_inserter(finishedTextures));
+            uploadedTextures.erase(uploadedTextures.begin(), unfinished);
+            pendingAmount -= finishedTextures.size();
+        }
+
+        for (auto &[request, texture, fence]: finishedTextures) {
+            glDeleteSync(fence);
+
+            // Counted here rather than on the upload thread, as frame stats belong to the main thread
+            countTextureLoad(texture.memory().gpuBytes);
+
+            if (auto placeholder = request.texture.lock()) {
+                *placeholder = std::move(texture);
+            }
+        }
+    }
+
+    bool TextureStreamer::isIdle() {
+        std::lock_guard lock(mutex);
+
+        return pendingAmount == 0;
+    }
+
+    void TextureStreamer::decodeImages() {
+        setTraceThreadName("Texture decode");
+
+        while (true) {
+            Request request;
+            {
+                std::unique_lock lock(mutex);
+                decodeCondition.wait(lock, [this]() { return isStopping || !decodeQueue.empty(); });
+                if (isStopping) return;
+
+                request = std::move(decodeQueue.front());
+                decodeQueue.pop_front();
+            }
+
+            try {
+                PROG2002_TRACE_SCOPE("TextureStreamer::decode");
+                auto image = request.data.empty() ? decodeImage(request.path) : decodeImage(request.data);
+
+                // Mip filters other than the GPU's read the pixels on the CPU, so those have to stay in CPU memory
+                std::optional<PixelUploadRing::Region> stagedPixels;
+                if (request.filtering != Filtering::LinearMipmap || request.mipmaps == Mipmaps::Gpu) {
+                    stagedPixels = pixelUploadRing.reserve((size_t) image.width * image.height * 4);
+                }
+                if (stagedPixels) {
+                    PROG2002_TRACE_SCOPE("TextureStreamer::stage");
+                    std::memcpy(stagedPixels->data, image.pixels.get(), stagedPixels->size);
+                    image.pixels.reset();
+                }
+
+                {
+                    std::lock_guard lock(mutex);
+                    uploadQueue.push_back(
+                        {.request = std::move(request), .image = std::move(image), .stagedPixels = stagedPixels}
+                    );
+                }
+                uploadCondition.notify_one();
+            } catch (const std::exception &exception) {
+                // Keeps the placeholder
+                auto name = request.data.empty() ? request.path : "an image in memory";
+                std::cerr << "Failed to stream " << name << ": " << exception.what() << std::endl;
+
+                std::lock_guard lock(mutex);
+                pendingAmount--;
+            }
+        }
+    }
+
+    void TextureStreamer::uploadImages() {
+        glfwMakeContextCurrent(uploadContext);
+        setTraceThreadName("Texture upload");
+
+        while (true) {
+            bool isStagingInUse = pixelUploadRing.reclaim();
+
+            DecodedImage decodedImage;
+            {
+                std::unique_lock lock(mutex);
+                auto isReady = [this]() { return isStopping || !uploadQueue.empty(); };
+
+                // Wakes up now and then while staged pixels are in flight, to free them for the decode threads
+                if (isStagingInUse) {
+                    if (!uploadCondition.wait_for(lock, std::chrono::milliseconds(1), isReady)) continue;
+                } else {
+                    uploadCondition.wait(lock, isReady);
+                }
+                if (isStopping) break;
+
+                decodedImage = std::move(uploadQueue.front());
+                uploadQueue.pop_front();
+            }
+
+            PROG2002_TRACE_SCOPE("TextureStreamer::upload");
+
+            auto &[request, image, stagedPixels] = decodedImage;
+            std::optional<StagedPixels> staged;
+            if (stagedPixels) {
+                staged = StagedPixels{.pixelBufferId = pixelUploadRing.bufferId(), .offset = stagedPixels->offset};
+            }
+
+            std::optional<Texture> texture;
+            try {
+                texture.emplace(
+                    createTexture(image, request.type, request.filtering, request.wrapping, request.mipmaps, staged)
+                );
+            } catch (const std::exception &exception) {
+                // Keeps the placeholder
+                auto name = request.data.empty() ? request.path : "an image in memory";
+                std::cerr << "Failed to upload " << name << ": " << exception.what() << std::endl;
+            }
+
+            // Whether or not the upload worked, the region is reused once the GPU is past it
+            if (stagedPixels) pixelUploadRing.retire(*stagedPixels);
+
+            if (!texture) {
+                glFlush();
+
+                std::lock_guard lock(mutex);
+                pendingAmount--;
+
+                continue;
+            }
+
+            // The main context may only use the texture once the GPU is done with the upload
+            auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            std::lock_guard lock(mutex);
+            uploadedTextures.push_back({.request = std::move(request), .texture = std::move(*texture), .fence = fence});
+        }
+
+        glfwMakeContextCurrent(nullptr);
+    }
+}
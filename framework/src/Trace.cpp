@@ -0,0 +1,237 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "framework/Trace.h"
+
+/**
+ * Every timeline of the process, owned here rather than by `thread_local` storage so that buffers of finished threads
+ * can still be written, and so that writing on exit does not race the destruction of the main thread's buffer
+ */
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<framework::TraceBuffer>> buffers;
+    std::unordered_map<std::string, framework::TraceBuffer *> tracks;
+    std::unordered_set<std::string> names;
+
+    std::filesystem::path path;
+    uint64_t epoch = 0;
+    bool isWriteOnExitRegistered = false;
+
+    framework::TraceBuffer &createBuffer(std::string name) {
+        auto trackId = (uint32_t) buffers.size() + 1;
+        buffers.push_back(std::make_unique<framework::TraceBuffer>(std::move(name), trackId));
+
+        return *buffers.back();
+    }
+};
+
+static TraceRegistry &traceRegistry() {
+    static TraceRegistry registry;
+
+    return registry;
+}
+
+/**
+ * Write `text` as a JSON string
+ */
+static void writeJsonString(std::ostream &output, const std::string &text) {
+    output << '"';
+
+    for (char character: text) {
+        if (character == '"' || character == '\\') output << '\\';
+        if ((unsigned char) character < 0x20) continue;
+
+        output << character;
+    }
+
+    output << '"';
+}
+
+/**
+ * Write `nanoseconds` as microseconds, the unit of trace timestamps, without losing precision to floating point
+ */
+static void writeMicroseconds(std::ostream &output, uint64_t nanoseconds) {
+    output << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+}
+
+namespace framework {
+    uint64_t traceTime() {
+        auto time = std::chrono::steady_clock::now().time_since_epoch();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    }
+
+    TraceBuffer::TraceBuffer(std::string name, uint32_t trackId) : name(std::move(name)), trackId(trackId) {}
+
+    TraceBuffer::~TraceBuffer() {
+        for (auto &chunk: chunks) delete[] chunk.load();
+    }
+
+    void TraceBuffer::record(const TraceEvent &event) {
+        auto index = eventsAmount.load(std::memory_order_relaxed);
+        auto chunkIndex = index / CHUNK_EVENTS;
+
+        if (chunkIndex >= MAX_CHUNKS) {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+
+            return;
+        }
+
+        auto chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = new TraceEvent[CHUNK_EVENTS];
+            chunks[chunkIndex].store(chunk, std::memory_order_release);
+        }
+
+        chunk[index % CHUNK_EVENTS] = event;
+
+        // Publishes the event, readers never look past the count
+        eventsAmount.store(index + 1, std::memory_order_release);
+    }
+
+    void TraceBuffer::rename(std::string newName) {
+        std::lock_guard lock(traceRegistry().mutex);
+        name = std::move(newName);
+    }
+
+    void TraceBuffer::writeEvents(std::ostream &output, uint64_t epoch) const {
+        output << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trackId << ",\"args\":{\"name\":";
+        writeJsonString(output, name);
+        output << "}}";
+
+        auto amount = eventsAmount.load(std::memory_order_acquire);
+
+        for (size_t index = 0; index < amount; ++index) {
+            auto chunk = chunks[index / CHUNK_EVENTS].load(std::memory_order_acquire);
+            auto &event = chunk[index % CHUNK_EVENTS];
+
+            // Events from before tracing was enabled, like a scope that was open at the time, start at 0
+            auto start = event.start > epoch ? event.start - epoch : 0;
+
+            output << ",\n{\"name\":";
+            writeJsonString(output, event.name);
+            output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << trackId << ",\"ts\":";
+            writeMicroseconds(output, start);
+            output << ",\"dur\":";
+            writeMicroseconds(output, event.duration);
+            output << "}";
+        }
+    }
+
+    const std::string &TraceBuffer::trackName() const {
+        return name;
+    }
+
+    size_t TraceBuffer::droppedEventsAmount() const {
+        return droppedEvents.load(std::memory_order_relaxed);
+    }
+
+    TraceScope::~TraceScope() {
+        if (name != nullptr) [[unlikely]] {
+            threadTraceBuffer().record({.name = name, .start = start, .duration = traceTime() - start});
+        }
+    }
+
+    void enableTracing(const std::filesystem::path &path) {
+        auto &registry = traceRegistry();
+
+        {
+            std::lock_guard lock(registry.mutex);
+            registry.path = path;
+            registry.epoch = traceTime();
+
+            // Registered after the registry exists, so it runs before the registry is destroyed
+            if (!registry.isWriteOnExitRegistered) {
+                registry.isWriteOnExitRegistered = true;
+                std::atexit([]() {
+                    try {
+                        writeTrace();
+                    } catch (const std::exception &exception) {
+                        std::cerr << exception.what() << std::endl;
+                    }
+                });
+            }
+        }
+
+        setTraceThreadName("Main");
+        isTracingEnabled.store(true, std::memory_order_relaxed);
+    }
+
+    void writeTrace() {
+        std::filesystem::path path;
+        {
+            std::lock_guard lock(traceRegistry().mutex);
+            path = traceRegistry().path;
+        }
+
+        if (path.empty()) return;
+
+        std::ofstream file(path);
+        if (!file) throw std::runtime_error("Failed to write trace to " + path.string());
+
+        writeTrace(file);
+    }
+
+    void writeTrace(std::ostream &output) {
+        auto &registry = traceRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        output << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"PROG2002"}})";
+
+        size_t droppedEvents = 0;
+        for (auto &buffer: registry.buffers) {
+            buffer->writeEvents(output, registry.epoch);
+            droppedEvents += buffer->droppedEventsAmount();
+        }
+
+        output << "\n]}\n";
+
+        if (droppedEvents > 0) {
+            std::cerr << "Trace dropped " << droppedEvents << " events, the buffers were full" << std::endl;
+        }
+    }
+
+    TraceBuffer &threadTraceBuffer() {
+        thread_local TraceBuffer *buffer = nullptr;
+
+        if (buffer == nullptr) [[unlikely]] {
+            auto &registry = traceRegistry();
+            std::lock_guard lock(registry.mutex);
+
+            buffer = &registry.createBuffer("Thread " + std::to_string(registry.buffers.size() + 1));
+        }
+
+        return *buffer;
+    }
+
+    void setTraceThreadName(std::string name) {
+        threadTraceBuffer().rename(std::move(name));
+    }
+
+    TraceBuffer &traceTrack(const std::string &name) {
+        auto &registry = traceRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        auto &track = registry.tracks[name];
+        if (track == nullptr) track = &registry.createBuffer(name);
+
+        return *track;
+    }
+
+    const char *traceName(const std::string &name) {
+        auto &registry = traceRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        // Elements of a node based set never move
+        return registry.names.insert(name).first->c_str();
+    }
+}
@@ -1,8 +1,27 @@
 #include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
 #include "framework/window.h"
+#include "framework/Trace.h"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
+/// State of the window made by `createWindow`
+static struct {
+    framework::WindowOptions options;
+    uint32_t framesSwapped = 0;
+
+    /// Whether F12 was down during the last swap, so holding it writes the trace once
+    bool wasPressingTraceKey = false;
+
+    /// Offscreen framebuffer drawn into instead of the window when headless
+    uint32_t framebufferId = 0;
+    uint32_t colorRenderbufferId = 0;
+    uint32_t depthRenderbufferId = 0;
+} mainWindow;
+
 static void glfwErrorCallback(int32_t code, const char *description) {
     std::cerr << "GLFW Error (0x" << std::hex << code << "): " << description << std::endl;
 }
@@ -81,18 +100,109 @@ static void GLAPIENTRY debugMessageCallback(
     }
 }
 
+/**
+ * Frame count given after `option`, exits with a usage error unless it is a whole number
+ */
+static uint32_t parseFrames(const char *value, const char *option) {
+    uint32_t frames = 0;
+    auto end = value != nullptr ? value + std::strlen(value) : nullptr;
+    auto [parsedEnd, error] = value != nullptr ? std::from_chars(value, end, frames) : std::from_chars_result{};
+
+    if (value == nullptr || error != std::errc() || parsedEnd != end || parsedEnd == value) {
+        std::cerr << option << " needs a whole number of frames, got " << (value != nullptr ? value : "nothing")
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return frames;
+}
+
+/**
+ * Create the framebuffer a headless window draws into, with the same attachments as a default framebuffer
+ */
+static void createOffscreenFramebuffer(int width, int height) {
+    glCreateRenderbuffers(1, &mainWindow.colorRenderbufferId);
+    glNamedRenderbufferStorage(mainWindow.colorRenderbufferId, GL_RGBA8, width, height);
+
+    glCreateRenderbuffers(1, &mainWindow.depthRenderbufferId);
+    glNamedRenderbufferStorage(mainWindow.depthRenderbufferId, GL_DEPTH24_STENCIL8, width, height);
+
+    glCreateFramebuffers(1, &mainWindow.framebufferId);
+    glNamedFramebufferRenderbuffer(
+        mainWindow.framebufferId,
+        GL_COLOR_ATTACHMENT0,
+        GL_RENDERBUFFER,
+        mainWindow.colorRenderbufferId
+    );
+    glNamedFramebufferRenderbuffer(
+        mainWindow.framebufferId,
+        GL_DEPTH_STENCIL_ATTACHMENT,
+        GL_RENDERBUFFER,
+        mainWindow.depthRenderbufferId
+    );
+
+    auto status = glCheckNamedFramebufferStatus(mainWindow.framebufferId, GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Offscreen framebuffer is incomplete");
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mainWindow.framebufferId);
+}
+
 namespace framework {
-    GLFWwindow *createWindow(int width, int height, const std::string &title) {
+    WindowOptions windowOptions(int argc, char *argv[]) {
+        WindowOptions options;
+
+        auto headlessFrames = std::getenv("PROG2002_HEADLESS");
+        if (headlessFrames != nullptr) {
+            options.headless = true;
+            options.frames = parseFrames(headlessFrames, "PROG2002_HEADLESS");
+        }
+
+        auto tracePath = std::getenv("PROG2002_TRACE");
+        if (tracePath != nullptr) options.tracePath = tracePath;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            auto value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+            if (argument == "--headless") {
+                options.headless = true;
+                options.frames = parseFrames(value, "--headless");
+                i++;
+            } else if (argument == "--frames") {
+                options.frames = parseFrames(value, "--frames");
+                i++;
+            } else if (argument == "--trace") {
+                if (value == nullptr) {
+                    std::cerr << "--trace needs a path to write the trace to" << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+
+                options.tracePath = value;
+                i++;
+            }
+        }
+
+        // Nothing could close an invisible window, so it would never finish
+        if (options.headless && options.frames == 0) {
+            std::cerr << "Headless runs need a frame count above 0" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        return options;
+    }
+
+    GLFWwindow *createWindow(int width, int height, const std::string &title, const WindowOptions &options) {
         glfwSetErrorCallback(glfwErrorCallback);
 
         auto didInitializeGlfw = glfwInit();
         if (!didInitializeGlfw) {
-            std::cerr << "Failed to initialize GLFW" << std::endl;
-
-            exit(EXIT_FAILURE);
+            throw std::runtime_error("Failed to initialize GLFW");
         }
 
         glfwWindowHint(GLFW_RESIZABLE, false);
+        glfwWindowHint(GLFW_VISIBLE, !options.headless);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -104,12 +214,12 @@ namespace framework {
             nullptr,
             nullptr
         );
+        glfwWindowHint(GLFW_VISIBLE, true);
 
         if (window == nullptr) {
-            std::cerr << "Failed to create GLFW window" << std::endl;
             glfwTerminate();
 
-            exit(EXIT_FAILURE);
+            throw std::runtime_error("Failed to create GLFW window");
         }
 
         // Set OpenGL context
@@ -117,22 +227,86 @@ namespace framework {
 
         auto didInitializeGlad = gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
         if (!didInitializeGlad) {
-            std::cerr << "Failed to initialize GLAD" << std::endl;
             glfwTerminate();
 
-            exit(EXIT_FAILURE);
+            throw std::runtime_error("Failed to initialize GLAD");
         }
 
         // Enable OpenGL debug output
         glEnable(GL_DEBUG_OUTPUT);
         glDebugMessageCallback(debugMessageCallback, nullptr);
 
+        mainWindow.options = options;
+        mainWindow.framesSwapped = 0;
+        if (options.headless) createOffscreenFramebuffer(width, height);
+        if (!options.tracePath.empty()) enableTracing(options.tracePath);
+
         // Print OpenGL information
         std::cout << "Vendor: " << glGetString(GL_VENDOR) << std::endl;
         std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
         std::cout << "OpenGL version: " << glGetString(GL_VERSION) << std::endl;
+        if (options.headless) std::cout << "Headless, " << options.frames << " frames" << std::endl;
         std::cout << std::endl;
 
         return window;
     }
+
+    void swapBuffers(GLFWwindow *window) {
+        PROG2002_TRACE_SCOPE("swapBuffers");
+
+        if (mainWindow.options.headless) {
+            // Nothing to present, but submit the frame like a swap would
+            glFlush();
+        } else {
+            glfwSwapBuffers(window);
+        }
+
+        mainWindow.framesSwapped++;
+        if (mainWindow.options.frames > 0 && mainWindow.framesSwapped >= mainWindow.options.frames) {
+            glfwSetWindowShouldClose(window, true);
+        }
+
+        if (isTracing()) {
+            bool isPressingTraceKey = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+            if (isPressingTraceKey && !mainWindow.wasPressingTraceKey) {
+                writeTrace();
+                std::cout << "Wrote trace to " << mainWindow.options.tracePath.string() << std::endl;
+            }
+
+            mainWindow.wasPressingTraceKey = isPressingTraceKey;
+        }
+    }
+
+    void destroyWindow(GLFWwindow *window) {
+        // Renderbuffers can only be deleted while the context is alive
+        if (mainWindow.framebufferId) {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &mainWindow.framebufferId);
+            glDeleteRenderbuffers(1, &mainWindow.colorRenderbufferId);
+            glDeleteRenderbuffers(1, &mainWindow.depthRenderbufferId);
+
+            mainWindow.framebufferId = 0;
+            mainWindow.colorRenderbufferId = 0;
+            mainWindow.depthRenderbufferId = 0;
+        }
+
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+
+    bool isHeadless() {
+        return mainWindow.options.headless;
+    }
+
+    GLFWwindow *createSharedContext(GLFWwindow *window) {
+        glfwWindowHint(GLFW_VISIBLE, false);
+        auto sharedContext = glfwCreateWindow(1, 1, "Shared context", nullptr, window);
+        glfwWindowHint(GLFW_VISIBLE, true);
+
+        if (sharedContext == nullptr) {
+            throw std::runtime_error("Failed to create shared context");
+        }
+
+        return sharedContext;
+    }
 }
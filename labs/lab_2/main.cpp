@@ -166,14 +166,14 @@ int main() {
         object.draw();
 
         // Swap front and back buffer
-        glfwSwapBuffers(window);
+        framework::swapBuffers(window);
 
         // Escape
         bool isPressingEscape = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
         if (isPressingEscape) break;
     }
 
-    glfwTerminate();
+    framework::destroyWindow(window);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -250,10 +250,10 @@ struct Cube {
         object.draw();
 
         // Draw wireframe
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        framework::renderState().setPolygonMode(GL_LINE);
         object.shader->uploadUniformFloat4("color", {0.f, 0.f, 0.f, 1.f});
         object.draw();
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        framework::renderState().setPolygonMode(GL_FILL);
     }
 };
 
@@ -288,7 +288,7 @@ int main() {
 
     glfwSetKeyCallback(window, keyCallback);
 
-    glEnable(GL_DEPTH_TEST);
+    framework::renderState().setDepthTest(true);
     // Clear color
     glClearColor(0.917f, 0.905f, 0.850f, 1.0f);
 
@@ -302,14 +302,14 @@ int main() {
         cube.draw();
 
         // Swap front and back buffer
-        glfwSwapBuffers(window);
+        framework::swapBuffers(window);
 
         // Escape
         bool isPressingEscape = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
         if (isPressingEscape) break;
     }
 
-    glfwTerminate();
+    framework::destroyWindow(window);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
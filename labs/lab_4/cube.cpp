@@ -92,8 +92,8 @@ void Cube::draw() const {
     object.draw();
 
     // Draw wireframe
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    framework::renderState().setPolygonMode(GL_LINE);
     object.shader->uploadUniformFloat4("color", {0.f, 0.f, 0.f, 1.f});
     object.draw();
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    framework::renderState().setPolygonMode(GL_FILL);
 }
\ No newline at end of file
@@ -29,7 +29,7 @@ int main() {
     glfwSetKeyCallback(window, handleKeyInput);
 
     // Enable depth
-    glEnable(GL_DEPTH_TEST);
+    framework::renderState().setDepthTest(true);
 
     // Enable blending
     glEnable(GL_BLEND);
@@ -48,14 +48,14 @@ int main() {
         cube.draw();
 
         // Swap front and back buffer
-        glfwSwapBuffers(window);
+        framework::swapBuffers(window);
 
         // Escape
         bool isPressingEscape = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
         if (isPressingEscape) break;
     }
 
-    glfwTerminate();
+    framework::destroyWindow(window);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
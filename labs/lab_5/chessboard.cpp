@@ -4,11 +4,12 @@
 #include "framework/Texture.h"
 #include "glm/ext/matrix_transform.hpp"
 #include "GLFW/glfw3.h"
-#include "framework/Camera.h"
+#include "framework/ShaderSource.h"
 
 // language=glsl
 const std::string vertexShaderSource = R"(
     #version 450 core
+    #include "framework/frame_uniforms.glsl"
 
     layout(location = 0) in vec2 position;
     layout(location = 1) in vec2 texture_coordinates;
@@ -19,14 +20,12 @@ const std::string vertexShaderSource = R"(
         vec2 grid_position;
     } vertex_data;
 
-    uniform mat4 projection;
-    uniform mat4 view;
     uniform mat4 model;
 
     void main() {
         vertex_data.texture_coordinates = texture_coordinates;
         vertex_data.grid_position = grid_position;
-        gl_Position = projection * view * model * vec4(position.xy, 0.0, 1.0);
+        gl_Position = frame.view_projection * model * vec4(position.xy, 0.0, 1.0);
     }
 )";
 
@@ -66,8 +65,11 @@ const std::string fragmentShaderSource = R"(
     }
 )";
 
-Chessboard Chessboard::create(framework::Camera camera) {
-    auto chessboardShader = std::make_shared<framework::Shader>(vertexShaderSource, fragmentShaderSource);
+Chessboard Chessboard::create() {
+    auto chessboardShader = std::make_shared<framework::Shader>(
+        framework::preprocessShader(vertexShaderSource),
+        framework::preprocessShader(fragmentShaderSource)
+    );
 
     // Chessboard mesh
     std::vector<Chessboard::Vertex> chessboardVertices = {
@@ -107,9 +109,7 @@ Chessboard Chessboard::create(framework::Camera camera) {
     chessboardModelMatrix = glm::rotate(chessboardModelMatrix, glm::radians(-80.f), glm::vec3(1.0, 0.0, 0.0));
     chessboardModelMatrix = glm::translate(chessboardModelMatrix, glm::vec3(0.f, 1.f, -0.5f));
 
-    // Transformation
-    chessboardShader->uploadUniformMatrix4("projection", camera.projectionMatrix);
-    chessboardShader->uploadUniformMatrix4("view", camera.viewMatrix());
+    // Transformation, projection and view come from the frame uniforms
     chessboardShader->uploadUniformMatrix4("model", chessboardModelMatrix);
 
     // Board size
@@ -135,12 +135,13 @@ Chessboard Chessboard::create(framework::Camera camera) {
     };
 }
 
-void Chessboard::draw(float ambientStrength) const {
-    object.shader->uploadUniformFloat1("ambient_strength", ambientStrength);
+void Chessboard::draw(framework::DrawQueue &drawQueue, float ambientStrength) const {
+    auto drawCommand = object.drawCommand()
+        .withUniform("ambient_strength", ambientStrength)
+        .withUniform("selected_tile", selectedTile)
+        .withTexture(0, texture);
 
-    object.shader->uploadUniformInt2("selected_tile", selectedTile);
-    texture.bind();
-    object.draw();
+    drawQueue.submit(std::move(drawCommand));
 }
 
 void Chessboard::handleKeyInput(int key, int action) {
@@ -6,6 +6,7 @@
 #include "framework/VertexArray.h"
 #include "framework/Texture.h"
 #include "framework/Camera.h"
+#include "framework/DrawQueue.h"
 
 const int BOARD_SIZE = 8;
 
@@ -26,9 +27,9 @@ struct Chessboard {
 
     glm::ivec2 selectedTile;
 
-    static Chessboard create(framework::Camera camera);
+    static Chessboard create();
 
-    void draw(float ambientStrength) const;
+    void draw(framework::DrawQueue &drawQueue, float ambientStrength) const;
 
     void handleKeyInput(int key, int action);
 };
@@ -1,9 +1,11 @@
 #include "cube.h"
 #include "framework/Camera.h"
+#include "framework/ShaderSource.h"
 
 // language=glsl
 const std::string vertexShaderSource = R"(
     #version 450 core
+    #include "framework/frame_uniforms.glsl"
 
     layout(location = 0) in vec3 position;
     layout(location = 1) in vec3 normal;
@@ -14,8 +16,6 @@ const std::string vertexShaderSource = R"(
         vec3 normal;
     } vertex_data;
 
-    uniform mat4 projection;
-    uniform mat4 view;
     uniform mat4 model;
 
     void main() {
@@ -23,13 +23,14 @@ const std::string vertexShaderSource = R"(
         vertex_data.texture_coordinates = position;
         vertex_data.normal = normalize((model * vec4(normal, 1.0)).xyz);
 
-        gl_Position = projection * view * model * vec4(position.xyz, 1.0);
+        gl_Position = frame.view_projection * model * vec4(position.xyz, 1.0);
     }
 )";
 
 // language=glsl
 const std::string fragmentShaderSource = R"(
     #version 450 core
+    #include "framework/frame_uniforms.glsl"
 
     in VertexData {
         vec3 position;
@@ -42,7 +43,6 @@ const std::string fragmentShaderSource = R"(
     layout(binding=0) uniform samplerCube texture_sampler;
     uniform vec4 color;
     uniform vec3 light_source_position;
-    uniform vec3 camera_position;
     uniform float ambient_strength;
     uniform vec3 light_color;
     uniform vec3 specular_color;
@@ -58,7 +58,7 @@ const std::string fragmentShaderSource = R"(
 
         // Specular
         vec3 reflected_light = normalize(reflect(-light_direction, vertex_data.normal));
-        vec3 observer_direction = normalize(camera_position - vertex_data.position);
+        vec3 observer_direction = normalize(frame.camera_position - vertex_data.position);
         float specular_factor = pow(max(dot(observer_direction, reflected_light), 0.0), 12);
         vec3 specular = specular_factor * specular_color;
 
@@ -70,7 +70,10 @@ const std::string fragmentShaderSource = R"(
 )";
 
 Cube Cube::create(GLFWwindow *window, framework::Camera camera) {
-    auto cubeShader = std::make_shared<framework::Shader>(vertexShaderSource, fragmentShaderSource);
+    auto cubeShader = std::make_shared<framework::Shader>(
+        framework::preprocessShader(vertexShaderSource),
+        framework::preprocessShader(fragmentShaderSource)
+    );
 
     // Chessboard mesh
     auto cubeVertices =
@@ -82,15 +85,11 @@ Cube Cube::create(GLFWwindow *window, framework::Camera camera) {
         });
 
     // Illumination
-    cubeShader->uploadUniformFloat3("camera_position", camera.position);
     cubeShader->uploadUniformFloat3("light_source_position", camera.position);
     cubeShader->uploadUniformFloat3("light_color", {2., 2., 1.});\
     cubeShader->uploadUniformFloat3("specular_color", {1., 1., 1.});
 
-    // Transformation, model is set in draw()
-    cubeShader->uploadUniformMatrix4("projection", camera.projectionMatrix);
-    cubeShader->uploadUniformMatrix4("view", camera.viewMatrix());
-
+    // Transformation, model is set in draw(), projection and view come from the frame uniforms
     auto object = framework::VertexArray(
         cubeShader,
         {
@@ -110,11 +109,7 @@ Cube Cube::create(GLFWwindow *window, framework::Camera camera) {
     };
 }
 
-void Cube::draw(float ambientStrength) const {
-    object.shader->uploadUniformFloat1("ambient_strength", ambientStrength);
-
-    texture.bind();
-
+void Cube::draw(framework::DrawQueue &drawQueue, float ambientStrength) const {
     // Set model matrix
     glm::dvec2 cursorPosition;
     glfwGetCursorPos(window, &cursorPosition.x, &cursorPosition.y);
@@ -124,15 +119,24 @@ void Cube::draw(float ambientStrength) const {
     modelMatrix *= glm::eulerAngleXY((float) cursorPosition.y / 500.f, (float) cursorPosition.x / 500.f);
     modelMatrix = glm::scale(modelMatrix, glm::vec3(0.5f));
 
-    object.shader->uploadUniformMatrix4("model", modelMatrix);
+    glm::vec3 center = {0.f, 0.2f, 0.f};
 
     // Draw fill
-    object.shader->uploadUniformFloat4("color", {1.f, 1.f, 1.f, 1.f});
-    object.draw();
-
-    // Draw wireframe
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    object.shader->uploadUniformFloat4("color", {0.f, 0.f, 0.f, 1.f});
-    object.draw();
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    auto fillCommand = object.drawCommand()
+        .withUniform("ambient_strength", ambientStrength)
+        .withUniform("model", modelMatrix)
+        .withUniform("color", glm::vec4(1.f, 1.f, 1.f, 1.f))
+        .withTexture(0, texture);
+
+    drawQueue.submit(std::move(fillCommand), framework::RenderPass::Opaque, center);
+
+    // Draw wireframe, same key as the fill so it is drawn after it
+    auto wireframeCommand = object.drawCommand()
+        .withUniform("ambient_strength", ambientStrength)
+        .withUniform("model", modelMatrix)
+        .withUniform("color", glm::vec4(0.f, 0.f, 0.f, 1.f))
+        .withTexture(0, texture)
+        .withPolygonMode(GL_LINE);
+
+    drawQueue.submit(std::move(wireframeCommand), framework::RenderPass::Opaque, center);
 }
\ No newline at end of file
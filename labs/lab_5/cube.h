@@ -10,6 +10,7 @@
 #include "glm/gtx/euler_angles.hpp"
 #include "GLFW/glfw3.h"
 #include "framework/Camera.h"
+#include "framework/DrawQueue.h"
 
 struct Cube {
     struct Vertex {
@@ -26,7 +27,7 @@ struct Cube {
 
     static Cube create(GLFWwindow *window, framework::Camera camera);
 
-    void draw(float ambientStrength) const;
+    void draw(framework::DrawQueue &drawQueue, float ambientStrength) const;
 };
 
 #endif //PROG2002_CUBE_H
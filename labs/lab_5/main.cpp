@@ -5,6 +5,8 @@
 #include "chessboard.h"
 #include "cube.h"
 #include "framework/Camera.h"
+#include "framework/FrameUniforms.h"
+#include "framework/DrawQueue.h"
 
 int main() {
     int width = 800;
@@ -20,8 +22,12 @@ int main() {
 
     auto camera = framework::Camera::createPerspective(45.f, aspectRatio, position, target, up);
 
+    auto frameUniforms = framework::FrameUniformBuffer::create();
+    framework::DrawQueue drawQueue;
+    drawQueue.setCameraPosition(camera.position);
+
     // Objects
-    static auto chessboard = Chessboard::create(camera);
+    static auto chessboard = Chessboard::create();
     auto cube = Cube::create(window, camera);
 
     // Handle input
@@ -31,7 +37,7 @@ int main() {
     glfwSetKeyCallback(window, handleKeyInput);
 
     // Enable depth
-    glEnable(GL_DEPTH_TEST);
+    framework::renderState().setDepthTest(true);
 
     // Clear color
     glm::vec3 backgroundColor = {0.917f, 0.905f, 0.850f};
@@ -48,21 +54,23 @@ int main() {
 
         // GLFW events
         glfwPollEvents();
+        frameUniforms.update(camera, time);
 
         // Draw
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        chessboard.draw(ambientStrength);
-        cube.draw(ambientStrength);
+        chessboard.draw(drawQueue, ambientStrength);
+        cube.draw(drawQueue, ambientStrength);
+        drawQueue.flush();
 
         // Swap front and back buffer
-        glfwSwapBuffers(window);
+        framework::swapBuffers(window);
 
         // Escape
         bool isPressingEscape = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
         if (isPressingEscape) break;
     }
 
-    glfwTerminate();
+    framework::destroyWindow(window);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include "framework/AssetPack.h"
+
+static void printUsage() {
+    std::cerr << "Usage: asset_packer <output.pack> <directory>" << std::endl;
+    std::cerr << "Every file below the directory is packed, named by its path relative to the directory." << std::endl;
+}
+
+/**
+ * Pack every file of a resource directory into one file, to open with `framework::AssetPack`.
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string outputPath = argv[1];
+    std::filesystem::path directory = argv[2];
+
+    try {
+        std::vector<framework::PackedFile> files;
+        for (auto &entry: std::filesystem::recursive_directory_iterator(directory)) {
+            if (!entry.is_regular_file()) continue;
+
+            files.push_back(
+                {
+                    .name = entry.path().lexically_relative(directory).generic_string(),
+                    .path = entry.path().string()
+                }
+            );
+        }
+
+        // Same order on every platform, so the same files give the same pack
+        std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) { return a.name < b.name; });
+
+        framework::writeAssetPack(outputPath, files);
+
+        std::cout << "Packed " << files.size() << " files into " << outputPath << std::endl;
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
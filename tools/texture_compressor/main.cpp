@@ -0,0 +1,112 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "framework/Texture.h"
+#include "framework/Mipmaps.h"
+#include "framework/TextureCompression.h"
+
+static void printUsage() {
+    std::cerr << "Usage: texture_compressor <input.png> <output.tex> [--format bc1|bc3] [--mipmaps box|kaiser|none]"
+              << std::endl;
+    std::cerr << "The format defaults to bc3 for images with transparency and bc1 otherwise." << std::endl;
+}
+
+/**
+ * @return Whether any pixel of the RGBA8 image is not fully opaque
+ */
+static bool hasTransparency(const framework::Image &image) {
+    auto pixelsAmount = (size_t) image.width * image.height;
+
+    for (size_t pixel = 0; pixel < pixelsAmount; ++pixel) {
+        if (image.pixels.get()[pixel * 4 + 3] != 255) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Convert an image to a block compressed texture with prebuilt mip levels, to load with
+ * `framework::loadCompressedTexture`.
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string inputPath = argv[1];
+    std::string outputPath = argv[2];
+    std::string formatName;
+    std::string mipmapsName = "kaiser";
+
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+
+        if (option == "--format") {
+            formatName = argv[i + 1];
+        } else if (option == "--mipmaps") {
+            mipmapsName = argv[i + 1];
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        auto startTime = std::chrono::steady_clock::now();
+        auto image = framework::decodeImage(inputPath);
+
+        framework::CompressedFormat format;
+        if (formatName == "bc1") {
+            format = framework::CompressedFormat::Bc1;
+        } else if (formatName == "bc3") {
+            format = framework::CompressedFormat::Bc3;
+        } else if (formatName.empty()) {
+            format = hasTransparency(image) ? framework::CompressedFormat::Bc3 : framework::CompressedFormat::Bc1;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        framework::CompressedTexture texture = {.format = format};
+        texture.levels.push_back(
+            {
+                .width = image.width,
+                .height = image.height,
+                .blocks = framework::compressPixels(image.pixels.get(), image.width, image.height, format)
+            }
+        );
+
+        if (mipmapsName != "none") {
+            auto filter = mipmapsName == "box" ? framework::Mipmaps::CpuBox : framework::Mipmaps::CpuKaiser;
+
+            for (auto &[width, height, pixels]: framework::generateMipmaps(
+                image.pixels.get(), image.width, image.height, filter
+            )) {
+                texture.levels.push_back(
+                    {
+                        .width = width,
+                        .height = height,
+                        .blocks = framework::compressPixels(pixels.data(), width, height, format)
+                    }
+                );
+            }
+        }
+
+        framework::writeCompressedTexture(outputPath, texture);
+
+        size_t compressedBytes = 0;
+        for (auto &level: texture.levels) compressedBytes += level.blocks.size();
+
+        auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+        std::cout << outputPath << ": " << (format == framework::CompressedFormat::Bc1 ? "BC1" : "BC3")
+                  << ", " << texture.levels.size() << " levels, " << compressedBytes << " bytes"
+                  << " (level 0 was " << (size_t) image.width * image.height * 4 << " bytes as RGBA8)"
+                  << ", " << milliseconds.count() << " ms" << std::endl;
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}